@@ -0,0 +1,16 @@
+#include <raylib.h>
+void raylib_js_set_entry(void (*entry)(void));
+static void frame(void)
+{
+    BeginDrawing();
+    ClearBackground(BLACK);
+    for (int i = 0; i < 30000; ++i) DrawRectangle(i%400, (i/400)%300, 1, 1, (Color){ 10, 20, 30, 255 });
+    DrawRectangle(0, 0, 50, 50, RED);
+    EndDrawing();
+}
+int main(void)
+{
+    InitWindow(400, 300, "big");
+    raylib_js_set_entry(frame);
+    return 0;
+}
@@ -41,7 +41,7 @@ int main()
     ball_position.x = w/2;
     ball_position.y = h/2;
 
-#ifdef PLATFORM_WEB
+#if defined(PLATFORM_WEB) && !defined(RAYLIB_JS_MAIN_LOOP)
     raylib_js_set_entry(GameFrame);
 #else
     while (!WindowShouldClose()) {
@@ -1147,13 +1147,17 @@ RLAPI void PlayAutomationEvent(AutomationEvent event);
 //------------------------------------------------------------------------------------
 
 // Input-related functions: keyboard
+#if !defined(PLATFORM_WEB)    // NOTE: PLATFORM_WEB defines these as static inline functions (see raylib.js section below)
 RLAPI bool IsKeyPressed(int key);                             // Check if a key has been pressed once
+#endif
 RLAPI bool IsKeyPressedRepeat(int key);                       // Check if a key has been pressed again (Only PLATFORM_DESKTOP)
+#if !defined(PLATFORM_WEB)
 RLAPI bool IsKeyDown(int key);                                // Check if a key is being pressed
 RLAPI bool IsKeyReleased(int key);                            // Check if a key has been released once
 RLAPI bool IsKeyUp(int key);                                  // Check if a key is NOT being pressed
 RLAPI int GetKeyPressed(void);                                // Get key pressed (keycode), call it multiple times for keys queued, returns 0 when the queue is empty
 RLAPI int GetCharPressed(void);                               // Get char pressed (unicode), call it multiple times for chars queued, returns 0 when the queue is empty
+#endif
 RLAPI void SetExitKey(int key);                               // Set a custom key to exit program (default is ESC)
 
 // Input-related functions: gamepads
@@ -1173,14 +1177,18 @@ RLAPI bool IsMouseButtonPressed(int button);                  // Check if a mous
 RLAPI bool IsMouseButtonDown(int button);                     // Check if a mouse button is being pressed
 RLAPI bool IsMouseButtonReleased(int button);                 // Check if a mouse button has been released once
 RLAPI bool IsMouseButtonUp(int button);                       // Check if a mouse button is NOT being pressed
+#if !defined(PLATFORM_WEB)    // NOTE: PLATFORM_WEB defines these as static inline functions (see raylib.js section below)
 RLAPI int GetMouseX(void);                                    // Get mouse position X
 RLAPI int GetMouseY(void);                                    // Get mouse position Y
 RLAPI Vector2 GetMousePosition(void);                         // Get mouse position XY
+#endif
 RLAPI Vector2 GetMouseDelta(void);                            // Get mouse delta between frames
 RLAPI void SetMousePosition(int x, int y);                    // Set mouse position XY
 RLAPI void SetMouseOffset(int offsetX, int offsetY);          // Set mouse offset
 RLAPI void SetMouseScale(float scaleX, float scaleY);         // Set mouse scaling
+#if !defined(PLATFORM_WEB)
 RLAPI float GetMouseWheelMove(void);                          // Get mouse wheel movement for X or Y, whichever is larger
+#endif
 RLAPI Vector2 GetMouseWheelMoveV(void);                       // Get mouse wheel movement for both X and Y
 RLAPI void SetMouseCursor(int cursor);                        // Set mouse cursor
 
@@ -1655,6 +1663,68 @@ RLAPI void DetachAudioStreamProcessor(AudioStream stream, AudioCallback processo
 RLAPI void AttachAudioMixedProcessor(AudioCallback processor); // Attach audio stream processor to the entire audio pipeline, receives the samples as <float>s
 RLAPI void DetachAudioMixedProcessor(AudioCallback processor); // Detach audio stream processor from the entire audio pipeline
 
+//------------------------------------------------------------------------------------
+// raylib.js: Input state shared with the host (PLATFORM_WEB)
+//------------------------------------------------------------------------------------
+// raylib.js keeps the input state up to date directly in the linear memory, so polling
+// the input is a plain memory read instead of a call into JavaScript.
+// NOTE: The layout has to be kept in sync with raylib.js
+#if defined(PLATFORM_WEB)
+#define RAYLIB_JS_MAX_KEYS              512     // Must be a multiple of 8, all the KeyboardKey values fit in
+#define RAYLIB_JS_MAX_INPUT_EVENTS      64      // Key and char events queued per frame
+
+typedef enum {
+    RAYLIB_JS_INPUT_EVENT_KEY = 0,      // value is a KeyboardKey
+    RAYLIB_JS_INPUT_EVENT_CHAR,         // value is a unicode codepoint
+} RaylibJsInputEventType;
+
+typedef struct RaylibJsInputEvent {
+    double time;                        // Event timestamp in milliseconds (performance.now() time origin)
+    int type;                           // RaylibJsInputEventType
+    int value;
+} RaylibJsInputEvent;
+
+typedef struct RaylibJsInput {
+    unsigned char currentKeyState[RAYLIB_JS_MAX_KEYS/8];    // Bitmap of the keys that are down
+    unsigned char previousKeyState[RAYLIB_JS_MAX_KEYS/8];   // Bitmap of the keys that were down in the previous frame
+    Vector2 mousePosition;              // Relative to the canvas
+    float mouseWheelMove;               // Accumulated during the current frame
+    unsigned int eventCount;            // Events queued by the host since the previous frame
+    unsigned int keyEventHead;          // Read cursor of GetKeyPressed()
+    unsigned int charEventHead;         // Read cursor of GetCharPressed()
+    RaylibJsInputEvent events[RAYLIB_JS_MAX_INPUT_EVENTS];
+} RaylibJsInput;
+
+extern RaylibJsInput raylib_js_input;   // Defined in src/raylib_js_input.c
+
+static inline bool RaylibJsKeyBit(const unsigned char *state, int key)
+{
+    return (key > 0) && (key < RAYLIB_JS_MAX_KEYS) && ((state[key >> 3] >> (key & 7)) & 1);
+}
+
+static inline bool IsKeyDown(int key) { return RaylibJsKeyBit(raylib_js_input.currentKeyState, key); }
+static inline bool IsKeyUp(int key) { return !RaylibJsKeyBit(raylib_js_input.currentKeyState, key); }
+static inline bool IsKeyPressed(int key) { return RaylibJsKeyBit(raylib_js_input.currentKeyState, key) && !RaylibJsKeyBit(raylib_js_input.previousKeyState, key); }
+static inline bool IsKeyReleased(int key) { return !RaylibJsKeyBit(raylib_js_input.currentKeyState, key) && RaylibJsKeyBit(raylib_js_input.previousKeyState, key); }
+
+static inline int RaylibJsNextInputEvent(unsigned int *head, int type)
+{
+    while (*head < raylib_js_input.eventCount) {
+        const RaylibJsInputEvent *event = &raylib_js_input.events[(*head)++];
+        if (event->type == type) return event->value;
+    }
+    return 0;
+}
+
+static inline int GetKeyPressed(void) { return RaylibJsNextInputEvent(&raylib_js_input.keyEventHead, RAYLIB_JS_INPUT_EVENT_KEY); }
+static inline int GetCharPressed(void) { return RaylibJsNextInputEvent(&raylib_js_input.charEventHead, RAYLIB_JS_INPUT_EVENT_CHAR); }
+
+static inline Vector2 GetMousePosition(void) { return raylib_js_input.mousePosition; }
+static inline int GetMouseX(void) { return (int)raylib_js_input.mousePosition.x; }
+static inline int GetMouseY(void) { return (int)raylib_js_input.mousePosition.y; }
+static inline float GetMouseWheelMove(void) { return raylib_js_input.mouseWheelMove; }
+#endif // PLATFORM_WEB
+
 #if defined(__cplusplus)
 }
 #endif
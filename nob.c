@@ -5,6 +5,7 @@ typedef struct {
     const char *src_path;
     const char *bin_path;
     const char *wasm_path;
+    const char *wasm_cflags;  // Optional additional flags for the wasm build
 } Example;
 
 Example examples[] = {
@@ -33,6 +34,13 @@ Example examples[] = {
         .bin_path = "./build/tsoding_ball",
         .wasm_path  = "./wasm/tsoding_ball.wasm",
     },
+    // The same game with its native loop instead of raylib_js_set_entry() for the jspi mode
+    // of raylib.js. Only built for the web.
+    {
+        .src_path    = "./examples/tsoding_ball.c",
+        .wasm_path   = "./wasm/tsoding_ball_loop.wasm",
+        .wasm_cflags = "-DRAYLIB_JS_MAIN_LOOP",
+    },
     {
         .src_path   = "./examples/tsoding_snake/tsoding_snake.c",
         .bin_path = "./build/tsoding_snake",
@@ -48,12 +56,134 @@ Example examples[] = {
         .bin_path   = "./build/text_writing_anim",
         .wasm_path  = "./wasm/text_writing_anim.wasm",
     },
+    {
+        .src_path   = "./examples/textures_logo_raylib.c",
+        .bin_path   = "./build/textures_logo_raylib",
+        .wasm_path  = "./wasm/textures_logo_raylib.wasm",
+    },
+};
+
+// The C side of raylib.js. It's linked into every wasm example. The optional features in
+// there are only compiled in when enabled with a -D flag (see README.md).
+const char *raylib_js_src_paths[] = {
+    "./src/raylib_js_commands.c",
+    "./src/raylib_js_input.c",
+    "./src/raylib_js_camera.c",
+    "./src/raylib_js_default_font.c",
+    "./src/raylib_js_software.c",
+    "./src/raylib_js_rlgl.c",
 };
 
+// Additional flags for the wasm builds passed to nob on the command line
+Nob_Cmd wasm_flags = {0};
+
+bool has_wasm_flag(const char *flag)
+{
+    for (size_t i = 0; i < wasm_flags.count; ++i) {
+        if (strcmp(wasm_flags.items[i], flag) == 0) return true;
+    }
+    return false;
+}
+
+// Parses the comma separated numbers of the C array initializer that follows `name` in `src`
+bool parse_c_array(Nob_String_View src, const char *name, unsigned int *items, size_t count)
+{
+    const char *start = strstr(src.data, name);
+    if (start == NULL) {
+        nob_log(NOB_ERROR, "Could not find %s", name);
+        return false;
+    }
+    const char *p = strchr(start, '{');
+    if (p == NULL) {
+        nob_log(NOB_ERROR, "Could not find the initializer of %s", name);
+        return false;
+    }
+    p += 1;
+    for (size_t i = 0; i < count; ++i) {
+        char *end = NULL;
+        items[i] = strtoul(p, &end, 0);
+        if (end == p) {
+            nob_log(NOB_ERROR, "%s has %zu items, but %zu were expected", name, i, count);
+            return false;
+        }
+        p = end;
+        while (*p == ',' || isspace(*p)) p += 1;
+    }
+    return true;
+}
+
+// The baked font is committed, so the builds don't need the raylib source tree. It's only baked
+// again when RAYLIB_SRC points at one.
+#define DEFAULT_FONT_HEADER_PATH "./src/raylib_js_default_font_data.h"
+
+#define DEFAULT_FONT_GLYPH_COUNT 224
+#define DEFAULT_FONT_ATLAS_SIZE 128
+#define DEFAULT_FONT_CHARS_HEIGHT 10
+#define DEFAULT_FONT_CHARS_DIVISOR 1
+
+// Bakes the default font of raylib into a header for src/raylib_js_default_font.c. The font is
+// taken from the same place LoadFontDefault() of raylib takes it from: the defaultFontData and
+// charsWidth arrays of src/rtext.c in the raylib source tree.
+bool bake_default_font(const char *rtext_path, const char *header_path)
+{
+    bool result = true;
+    Nob_String_Builder src = {0};
+    Nob_String_Builder out = {0};
+
+    if (!nob_read_entire_file(rtext_path, &src)) nob_return_defer(false);
+    nob_sb_append_null(&src);
+
+    unsigned int atlas[DEFAULT_FONT_ATLAS_SIZE*DEFAULT_FONT_ATLAS_SIZE/32];
+    unsigned int widths[DEFAULT_FONT_GLYPH_COUNT];
+    if (!parse_c_array(nob_sb_to_sv(src), "defaultFontData[", atlas, NOB_ARRAY_LEN(atlas))) nob_return_defer(false);
+    if (!parse_c_array(nob_sb_to_sv(src), "charsWidth[", widths, NOB_ARRAY_LEN(widths))) nob_return_defer(false);
+
+    nob_sb_appendf(&out, "// Generated by nob.c from %s. DO NOT EDIT!\n", rtext_path);
+    nob_sb_appendf(&out, "static const RaylibJsDefaultFont raylib_js_default_font_data = {\n");
+    nob_sb_appendf(&out, "    .baseSize = %d,\n", DEFAULT_FONT_CHARS_HEIGHT);
+    nob_sb_appendf(&out, "    .glyphCount = %d,\n", DEFAULT_FONT_GLYPH_COUNT);
+    nob_sb_appendf(&out, "    .atlasWidth = %d,\n", DEFAULT_FONT_ATLAS_SIZE);
+    nob_sb_appendf(&out, "    .atlasHeight = %d,\n", DEFAULT_FONT_ATLAS_SIZE);
+    nob_sb_appendf(&out, "    .atlas = {");
+    for (size_t i = 0; i < NOB_ARRAY_LEN(atlas); ++i) {
+        if (i%8 == 0) nob_sb_appendf(&out, "\n       ");
+        nob_sb_appendf(&out, " 0x%08x,", atlas[i]);
+    }
+    nob_sb_appendf(&out, "\n    },\n");
+
+    // The glyphs are laid out in the atlas the same way LoadFontDefault() of raylib expects them
+    nob_sb_appendf(&out, "    .recs = {\n");
+    int line = 0;
+    int x = DEFAULT_FONT_CHARS_DIVISOR;
+    for (size_t i = 0; i < DEFAULT_FONT_GLYPH_COUNT; ++i) {
+        int rec_x = x;
+        int next_x = x + widths[i] + DEFAULT_FONT_CHARS_DIVISOR;
+        if (next_x >= DEFAULT_FONT_ATLAS_SIZE) {
+            line += 1;
+            rec_x = DEFAULT_FONT_CHARS_DIVISOR;
+            next_x = 2*DEFAULT_FONT_CHARS_DIVISOR + widths[i];
+        }
+        x = next_x;
+        int rec_y = DEFAULT_FONT_CHARS_DIVISOR + line*(DEFAULT_FONT_CHARS_HEIGHT + DEFAULT_FONT_CHARS_DIVISOR);
+        nob_sb_appendf(&out, "        { %d, %d, %u, %d },\n", rec_x, rec_y, widths[i], DEFAULT_FONT_CHARS_HEIGHT);
+    }
+    nob_sb_appendf(&out, "    },\n");
+    nob_sb_appendf(&out, "};\n");
+
+    if (!nob_write_entire_file(header_path, out.items, out.count)) nob_return_defer(false);
+    nob_log(NOB_INFO, "Baked the default font from %s into %s", rtext_path, header_path);
+
+defer:
+    nob_sb_free(src);
+    nob_sb_free(out);
+    return result;
+}
+
 bool build_native(void)
 {
     Nob_Cmd cmd = {0};
     for (size_t i = 0; i < NOB_ARRAY_LEN(examples); ++i) {
+        if (examples[i].bin_path == NULL) continue;
         cmd.count = 0;
         nob_cmd_append(&cmd, "clang", "-I./include/");
         nob_cmd_append(&cmd, "-o", examples[i].bin_path, examples[i].src_path);
@@ -78,15 +208,78 @@ bool build_wasm(void)
         nob_cmd_append(&cmd, "-o");
         nob_cmd_append(&cmd, examples[i].wasm_path);
         nob_cmd_append(&cmd, examples[i].src_path);
+        for (size_t j = 0; j < NOB_ARRAY_LEN(raylib_js_src_paths); ++j) {
+            nob_cmd_append(&cmd, raylib_js_src_paths[j]);
+        }
         nob_cmd_append(&cmd, "-DPLATFORM_WEB");
+        if (examples[i].wasm_cflags != NULL) nob_cmd_append(&cmd, examples[i].wasm_cflags);
+        nob_da_append_many(&cmd, wasm_flags.items, wasm_flags.count);
+        // The software renderer fills and blends 4 pixels at a time with wasm SIMD
+        if (has_wasm_flag("-DRAYLIB_JS_SOFTWARE_RENDERER")) nob_cmd_append(&cmd, "-msimd128");
         if (!nob_cmd_run_sync(cmd)) return 1;
     }
 }
 
+// The checks of tests/. The software renderer is built with and without wasm SIMD, and Node
+// compares the pixels the two draw.
+bool run_tests(void)
+{
+    Nob_Cmd cmd = {0};
+    const char *variants[][2] = {
+        { "./build/software_renderer_scalar.wasm", NULL },
+        { "./build/software_renderer_simd.wasm", "-msimd128" },
+    };
+    for (size_t i = 0; i < NOB_ARRAY_LEN(variants); ++i) {
+        cmd.count = 0;
+        nob_cmd_append(&cmd, "clang");
+        nob_cmd_append(&cmd, "--target=wasm32");
+        nob_cmd_append(&cmd, "-I./include");
+        nob_cmd_append(&cmd, "-I./src");
+        nob_cmd_append(&cmd, "--no-standard-libraries");
+        nob_cmd_append(&cmd, "-Wl,--no-entry");
+        nob_cmd_append(&cmd, "-Wl,--allow-undefined");
+        nob_cmd_append(&cmd, "-DPLATFORM_WEB");
+        nob_cmd_append(&cmd, "-DRAYLIB_JS_SOFTWARE_RENDERER");
+        nob_cmd_append(&cmd, "-DRAYLIB_JS_DEFAULT_FONT");
+        if (variants[i][1] != NULL) nob_cmd_append(&cmd, variants[i][1]);
+        nob_cmd_append(&cmd, "-o", variants[i][0]);
+        nob_cmd_append(&cmd, "./tests/software_renderer.c");
+        nob_cmd_append(&cmd, "./src/raylib_js_software.c");
+        nob_cmd_append(&cmd, "./src/raylib_js_default_font.c");
+        if (!nob_cmd_run_sync(cmd)) return false;
+    }
+    cmd.count = 0;
+    nob_cmd_append(&cmd, "node", "./tests/software_renderer.js");
+    return nob_cmd_run_sync(cmd);
+}
+
 int main(int argc, char **argv)
 {
     NOB_GO_REBUILD_URSELF(argc, argv);
+    const char *program = nob_shift_args(&argc, &argv);
+    bool test = false;
+    while (argc > 0) {
+        const char *flag = nob_shift_args(&argc, &argv);
+        if (strcmp(flag, "test") == 0) {
+            test = true;
+            continue;
+        }
+        if (strncmp(flag, "-D", 2) != 0) {
+            nob_log(NOB_ERROR, "Unknown flag %s", flag);
+            nob_log(NOB_INFO, "Usage: %s [test] [-D<feature>...]", program);
+            return 1;
+        }
+        nob_cmd_append(&wasm_flags, flag);
+    }
     if (!nob_mkdir_if_not_exists("build/")) return 1;
+    const char *raylib_src = getenv("RAYLIB_SRC");
+    if (raylib_src != NULL) {
+        if (!bake_default_font(nob_temp_sprintf("%s/rtext.c", raylib_src), DEFAULT_FONT_HEADER_PATH)) return 1;
+    } else if ((test || has_wasm_flag("-DRAYLIB_JS_DEFAULT_FONT")) && !nob_file_exists(DEFAULT_FONT_HEADER_PATH)) {
+        nob_log(NOB_ERROR, "%s is missing. Bake it from the raylib source tree with RAYLIB_SRC=<raylib>/src %s", DEFAULT_FONT_HEADER_PATH, program);
+        return 1;
+    }
+    if (test) return run_tests() ? 0 : 1;
     build_native();
     build_wasm();
     return 0;
@@ -21,6 +21,124 @@ const LOG_ERROR   = iota++; // Error logging, used on unrecoverable failures
 const LOG_FATAL   = iota++; // Fatal logging, used to abort program: exit(EXIT_FAILURE)
 const LOG_NONE    = iota++; // Disable logging
 
+const PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 = 7; // 8*4 bpp (4 channels)
+
+// The size LoadTexture() reports for the images that are not decoded yet
+const TEXTURE_PENDING_SIZE = 256;
+
+// Opcodes of the command buffer. Keep in sync with RaylibJsCommandOp in src/raylib_js.h
+iota = 0;
+const CMD_CLEAR_BACKGROUND     = iota++;
+const CMD_DRAW_RECTANGLE       = iota++;
+const CMD_DRAW_RECTANGLE_LINES = iota++;
+const CMD_DRAW_CIRCLE          = iota++;
+const CMD_DRAW_TEXT            = iota++;
+const CMD_DRAW_TEXT_EX         = iota++;
+const CMD_DRAW_TEXTURE         = iota++;
+const CMD_DRAW_TEXTURE_PRO     = iota++;
+const CMD_SET_TRANSFORM        = iota++;
+const CMD_BEGIN_LAYER          = iota++;
+const CMD_END_LAYER            = iota++;
+const CMD_DRAW_LAYER           = iota++;
+const CMD_UNLOAD_LAYER         = iota++;
+const CMD_DRAW_BATCH           = iota++;
+
+const FRAME_PACING_TOLERANCE_MS = 1.0;
+const MAX_FRAME_TIME            = 0.25;  // in seconds, anything longer is the game being paused by the browser
+const MAX_FIXED_STEPS_PER_TICK  = 5;
+const FPS_CAPTURE_FRAMES_COUNT  = 30;
+
+// Keep in sync with src/raylib_js.h
+const DEFAULT_FONT_BASE_SIZE    = 10;
+const DEFAULT_FONT_LINE_SPACING = 2;
+
+// Layout of RaylibJsInput. Keep in sync with include/raylib.h
+const INPUT_MAX_KEYS           = 512;
+const INPUT_MAX_EVENTS         = 64;
+const INPUT_CURRENT_KEY_STATE  = 0;
+const INPUT_PREVIOUS_KEY_STATE = INPUT_CURRENT_KEY_STATE + INPUT_MAX_KEYS/8;
+const INPUT_MOUSE_POSITION     = INPUT_PREVIOUS_KEY_STATE + INPUT_MAX_KEYS/8;
+const INPUT_MOUSE_WHEEL_MOVE   = INPUT_MOUSE_POSITION + 8;
+const INPUT_EVENT_COUNT        = INPUT_MOUSE_WHEEL_MOVE + 4;
+const INPUT_KEY_EVENT_HEAD     = INPUT_EVENT_COUNT + 4;
+const INPUT_CHAR_EVENT_HEAD    = INPUT_KEY_EVENT_HEAD + 4;
+const INPUT_EVENTS             = INPUT_CHAR_EVENT_HEAD + 4;
+const INPUT_EVENT_SIZE         = 16;
+iota = 0;
+const INPUT_EVENT_KEY  = iota++;
+const INPUT_EVENT_CHAR = iota++;
+
+// Layout of RaylibJsFramebuffer. Keep in sync with src/raylib_js.h
+const FRAMEBUFFER_WIDTH    = 0;
+const FRAMEBUFFER_HEIGHT   = 4;
+const FRAMEBUFFER_CAPACITY = 8;
+const FRAMEBUFFER_PIXELS   = 12;
+
+// Layout of RaylibJsTransform. Keep in sync with src/raylib_js.h
+const TRANSFORM_VERSION       = 0;
+const TRANSFORM_MATRIX        = 4;  // a, b, c, d, e, f as in ctx.setTransform()
+const TRANSFORM_SCREEN_WIDTH  = 28;
+const TRANSFORM_SCREEN_HEIGHT = 32;
+const TRANSFORM_CULLED        = 36;
+
+// Layout of RaylibJsRenderBatch. Keep in sync with src/raylib_js.h
+const BATCH_MAX_DRAWS    = 256;
+const BATCH_VERTEX_COUNT = 0;
+const BATCH_DRAW_COUNT   = 4;
+const BATCH_DRAWS        = 8;
+const BATCH_DRAW_SIZE    = 16;
+const BATCH_VERTICES     = BATCH_DRAWS + BATCH_MAX_DRAWS*BATCH_DRAW_SIZE;
+const BATCH_VERTEX_SIZE  = 20;
+
+// The modes of the draws of rlgl. Keep in sync with include/rlgl.h
+const RL_LINES     = 0x0001;
+const RL_TRIANGLES = 0x0004;
+const RL_QUADS     = 0x0007;
+
+// Messages between the page and the worker of the worker mode, see RaylibJs.#startWorker()
+iota = 0;
+const WORKER_START          = iota++; // [op, wasmPath, canvas, options]
+const WORKER_START_BLOCKING = iota++; // [op, wasmPath, ring, options]
+const WORKER_KEY_DOWN       = iota++; // [op, key, char, repeat, time]
+const WORKER_KEY_UP         = iota++; // [op, key]
+const WORKER_RELEASE_KEYS   = iota++; // [op]
+const WORKER_MOUSE_MOVE     = iota++; // [op, x, y]
+const WORKER_MOUSE_WHEEL    = iota++; // [op, move]
+const WORKER_VISIBILITY     = iota++; // [op, visible]
+// From the worker to the page
+const WORKER_INIT_WINDOW    = iota++; // [op, width, height, title]
+const WORKER_LOAD_TEXTURE   = iota++; // [op, id, url, bitmap], blocking mode only
+const WORKER_UNLOAD_TEXTURE = iota++; // [op, id], blocking mode only
+const WORKER_LOAD_FONT      = iota++; // [op, id, url], blocking mode only
+const WORKER_UNLOAD_FONT    = iota++; // [op, id], blocking mode only
+const WORKER_DEFAULT_FONT   = iota++; // [op, bytes of RaylibJsDefaultFont], blocking mode only
+const WORKER_LOAD_PIXELS    = iota++; // [op, id, width, height, pixels], blocking mode only
+const WORKER_UPDATE_PIXELS  = iota++; // [op, id, x, y, width, height, pixels], blocking mode only
+const WORKER_RING           = iota++; // [op, buffer of the FrameRing that replaces the page's], blocking mode only
+
+// Layout of the SharedArrayBuffer of the blocking worker mode (see FrameRing), in words
+const RING_SLOTS             = 2;
+const RING_DEFAULT_SLOT_CAPACITY = 64*1024; // The default RAYLIB_JS_COMMAND_BUFFER_CAPACITY
+const RING_PUBLISHED         = 0;
+const RING_PRESENTED         = 1;
+const RING_TARGET_FPS        = 2;
+const RING_INPUT_SEQ         = 3;
+const RING_INPUT_ACK         = 4;
+const RING_SLOT_CAPACITY     = 5;  // in words, a flush of the command buffer always fits
+const RING_SLOT_HEADERS      = 8;  // [count, final] for every slot
+const RING_INPUT_KEYS        = 16;
+const RING_INPUT_MOUSE       = RING_INPUT_KEYS + INPUT_MAX_KEYS/32;
+const RING_INPUT_WHEEL       = RING_INPUT_MOUSE + 2;
+const RING_INPUT_EVENT_COUNT = RING_INPUT_WHEEL + 1;
+const RING_INPUT_EVENTS      = RING_INPUT_EVENT_COUNT + 1; // [serial, type, value, pad, time as f64]
+const RING_EVENT_SIZE        = 6;
+const RING_SLOTS_BEGIN       = 512;
+
+// Thrown by EndDrawing() of the instance scouting for assets, see RaylibJs.#preload()
+const SCOUTING_DONE = Symbol("SCOUTING_DONE");
+
+const IS_WORKER = typeof WorkerGlobalScope !== "undefined" && self instanceof WorkerGlobalScope;
+
 class RaylibJs {
     // TODO: We stole the font from the website
     // (https://raylib.com/) and it's slightly different than
@@ -31,376 +149,2925 @@ class RaylibJs {
     // It would be nice to have a better approach...
     #FONT_SCALE_MAGIC = 0.65;
 
-    #reset() {
-        this.previous = undefined;
-        this.exports = undefined;
-        this.ctx = undefined;
-        this.dt = undefined;
-        this.targetFPS = 60;
-        this.entryFunction = undefined;
-        this.prevPressedKeyState = new Set();
-        this.currentPressedKeyState = new Set();
-        this.currentMouseWheelMoveState = 0;
-        this.currentMousePosition = {x: 0, y: 0};
-        this.images = [];
-        this.quit = false;
+    // Upper bound on the amount of distinct colors we remember. Fading animations can produce a
+    // lot of one-off colors, so instead of growing forever the cache just starts over.
+    #COLOR_CACHE_CAPACITY = 4096;
+
+    // Same for the decoded C strings.
+    #CSTR_CACHE_CAPACITY = 1024;
+
+    // Amount of text measurements kept by the LRU cache of #measureText().
+    #MEASURE_CACHE_CAPACITY = 512;
+
+    // Glyph atlases kept at once, see #glyphAtlas().
+    #GLYPH_ATLAS_CAPACITY = 8;
+
+    // Bytes of the tinted copies of the textures kept by TintCache.
+    #TINT_CACHE_BYTES = 32*1024*1024;
+
+    #reset() {
+        this.previous = undefined;
+        this.previousFrame = undefined;
+        this.fixedTimestep = false;
+        this.accumulator = 0;
+        this.backgroundFPS = 0;
+        this.pageVisible = true;
+        this.onScreen = true;
+        this.visible = true;
+        this.hiddenSince = undefined;
+        this.hiddenFrames = 0;
+        this.resuming = false;
+        this.startTime = performance.now();
+        this.frameTimes = new Float64Array(FPS_CAPTURE_FRAMES_COUNT);
+        this.frameTimesIndex = 0;
+        this.exports = undefined;
+        this.buffer = undefined;
+        this.u8 = undefined;
+        this.u32 = undefined;
+        this.i32 = undefined;
+        this.f32 = undefined;
+        this.f64 = undefined;
+        this.ctx = undefined;
+        this.canvas = undefined;
+        this.worker = undefined;
+        this.ring = undefined;
+        this.ringInputSeq = 0;
+        this.ringEvents = [];
+        this.ringEventSerial = 0;
+        this.dt = undefined;
+        this.targetFPS = 60;
+        this.entryFunction = undefined;
+        this.jspi = false;
+        this.suspendsMain = false;
+        // Don't keep the scheduler waiting for a frame that will never be over
+        this.frameDone?.resolve();
+        this.frameDone = undefined;
+        this.commandBuffer = undefined;
+        this.inputState = undefined;
+        this.framebuffer = undefined;
+        this.framebufferImage = undefined;
+        this.renderBatch = undefined;
+        this.vertexColorsWarned = false;
+        this.transformState = undefined;
+        this.transformVersion = undefined;   // of the transform of transformState applied to ctx
+        this.transform = [1, 0, 0, 1, 0, 0]; // applied to ctx
+        this.layers = new Map();             // id -> {ctx, dirty, stats}, see BeginLayer()
+        this.layerTarget = undefined;        // what ctx was before BeginLayer()
+        this.prevPressedKeyState = new Uint8Array(INPUT_MAX_KEYS/8);
+        this.currentPressedKeyState = new Uint8Array(INPUT_MAX_KEYS/8);
+        this.currentMouseWheelMoveState = 0;
+        this.currentMousePosition = {x: 0, y: 0};
+        this.mouseClientX = 0;
+        this.mouseClientY = 0;
+        this.mousePositionDirty = false;
+        this.canvasRect = undefined;
+        this.frameLayoutReads = 0;
+        this.textures = new ResourceSlots(); // id -> {path, bitmap} or the texture of an Image, see LoadTextureFromImage()
+        this.fonts = new ResourceSlots();    // id -> {path, family}
+        this.decoded = new Map();            // path -> {bitmap, refs, ...} of the decoded images
+        this.fontFaces = new Map();          // path -> {face, family, refs}
+        this.assets = [];                    // what #preload() loaded and how long it took
+        this.scouting = undefined;
+        this.colorCache = new Map();
+        this.cstrCache = new Map();
+        this.measureCache = new Map();
+        this.glyphAtlases = undefined;
+        this.defaultFont = undefined;
+        this.ctxState = {};
+        this.frameStateChangesSkipped = 0;
+        this.stats = {
+            colorCacheHits: 0,
+            colorCacheMisses: 0,
+            cstrCacheHits: 0,
+            cstrCacheMisses: 0,
+            measureCacheHits: 0,
+            measureCacheMisses: 0,
+            stateChangesSkipped: 0,
+            lastFrameStateChangesSkipped: 0,
+            layoutReads: 0,
+            lastFrameLayoutReads: 0,
+            pacingSkippedTicks: 0,
+            droppedSteps: 0,
+            hiddenSkippedFrames: 0,
+            budgetSkippedTicks: 0,
+            textures: 0,
+            textureBytes: 0,
+            fonts: 0,
+            tintCacheHits: 0,
+            tintCacheMisses: 0,
+            tintCacheBytes: 0,
+            batchFlushes: 0,
+            batchDraws: 0,
+            batchVertices: 0,
+            transformChanges: 0,
+            culledDraws: 0,
+            layers: {},                      // id -> {redraws, draws}
+        };
+        this.tintCache = new TintCache(this.#TINT_CACHE_BYTES, this.stats);
+        this.quit = false;
+    }
+
+    constructor() {
+        this.#reset();
+    }
+
+    // The views over the wasm memory are long-lived so the imports don't allocate on every
+    // call. memory.grow() replaces the underlying ArrayBuffer, so we recreate them whenever
+    // it has changed.
+    #syncViews() {
+        const buffer = this.exports.memory.buffer;
+        if (this.buffer !== buffer) {
+            this.buffer = buffer;
+            this.u8 = new Uint8Array(buffer);
+            this.u32 = new Uint32Array(buffer);
+            this.i32 = new Int32Array(buffer);
+            this.f32 = new Float32Array(buffer);
+            this.f64 = new Float64Array(buffer);
+        }
+    }
+
+    #colorFromMemory(color_ptr) {
+        return this.#color(this.#packedColorFromMemory(color_ptr));
+    }
+
+    #packedColorFromMemory(color_ptr) {
+        const u8 = this.u8;
+        return (u8[color_ptr] | (u8[color_ptr + 1]<<8) | (u8[color_ptr + 2]<<16) | (u8[color_ptr + 3]<<24))>>>0;
+    }
+
+    // Converts a packed RGBA color into a CSS color string. The strings are cached by the
+    // packed value, so a repeated color costs a single Map lookup.
+    #color(packed) {
+        let color = this.colorCache.get(packed);
+        if (color !== undefined) {
+            this.stats.colorCacheHits += 1;
+            return color;
+        }
+        this.stats.colorCacheMisses += 1;
+        if (this.colorCache.size >= this.#COLOR_CACHE_CAPACITY) this.colorCache.clear();
+        color = color_hex(packed);
+        this.colorCache.set(packed, color);
+        return color;
+    }
+
+    // Decodes the C string at ptr. Text is usually drawn from the same static strings (or
+    // buffers) every frame, so the decoded strings are interned by their pointer and
+    // revalidated by the length and the hash of the content.
+    #cstr(ptr) {
+        const u8 = this.u8;
+        let end = u8.indexOf(0, ptr);
+        if (end < 0) end = u8.length;
+        // FNV-1a
+        let hash = 0x811c9dc5;
+        let bits = 0;
+        for (let i = ptr; i < end; ++i) {
+            hash = Math.imul(hash ^ u8[i], 0x01000193);
+            bits |= u8[i];
+        }
+        const length = end - ptr;
+        let entry = this.cstrCache.get(ptr);
+        if (entry !== undefined && entry.length === length && entry.hash === hash) {
+            this.stats.cstrCacheHits += 1;
+            return entry.text;
+        }
+        this.stats.cstrCacheMisses += 1;
+        const text = utf8_decode(u8, ptr, end, bits < 0x80);
+        if (entry === undefined) {
+            if (this.cstrCache.size >= this.#CSTR_CACHE_CAPACITY) this.cstrCache.clear();
+            entry = {};
+            this.cstrCache.set(ptr, entry);
+        }
+        entry.length = length;
+        entry.hash = hash;
+        entry.text = text;
+        return text;
+    }
+
+    // ctx.measureText() is one of the slowest calls of the canvas, while the same labels are
+    // measured over and over again. So the widths are kept in an LRU cache keyed by the CSS font
+    // (which identifies both the font and the size) and the text.
+    #measureText(font, text) {
+        const key = font + "\n" + text;
+        let width = this.measureCache.get(key);
+        if (width !== undefined) {
+            this.stats.measureCacheHits += 1;
+            // Map iterates in insertion order, so reinserting makes the entry the most recent one
+            this.measureCache.delete(key);
+            this.measureCache.set(key, width);
+            return width;
+        }
+        this.stats.measureCacheMisses += 1;
+        this.#ctxSet("font", font);
+        width = this.ctx.measureText(text).width;
+        if (this.measureCache.size >= this.#MEASURE_CACHE_CAPACITY) {
+            this.measureCache.delete(this.measureCache.keys().next().value);
+        }
+        this.measureCache.set(key, width);
+        return width;
+    }
+
+    // Until a font is loaded the canvas renders and measures the text with a fallback one, so
+    // everything we cached about fonts becomes stale whenever a font finishes loading.
+    #fontsChanged() {
+        this.measureCache.clear();
+        if (this.glyphAtlases !== undefined) {
+            for (const atlas of this.glyphAtlases.values()) atlas.release();
+            this.glyphAtlases.clear();
+        }
+    }
+
+    // The glyphs are rasterized at whole pixel sizes and scaled to the fractional ones, so an
+    // animated font size doesn't make a new atlas every frame. The atlases are kept in an LRU.
+    #glyphAtlas(family, fontSize) {
+        const font = `${Math.max(1, Math.round(fontSize))}px ${family}`;
+        let atlas = this.glyphAtlases.get(font);
+        if (atlas !== undefined) {
+            // Map iterates in insertion order, so reinserting makes the entry the most recent one
+            this.glyphAtlases.delete(font);
+        } else {
+            if (this.glyphAtlases.size >= this.#GLYPH_ATLAS_CAPACITY) {
+                const [oldest, evicted] = this.glyphAtlases.entries().next().value;
+                evicted.release();
+                this.glyphAtlases.delete(oldest);
+            }
+            atlas = new GlyphAtlas(font, Math.max(1, Math.round(fontSize)));
+        }
+        this.glyphAtlases.set(font, atlas);
+        return atlas;
+    }
+
+    // Canvas parses fillStyle, font, etc. on every assignment even if the value didn't change.
+    // So we keep a shadow copy of the properties we touch and only write the ones that differ.
+    #ctxSet(name, value) {
+        if (this.ctxState[name] === value) {
+            this.frameStateChangesSkipped += 1;
+            return;
+        }
+        this.ctxState[name] = value;
+        this.ctx[name] = value;
+    }
+
+    #setKeyState(key, down) {
+        const byte = key>>3;
+        const mask = 1<<(key&7);
+        if (down) {
+            this.currentPressedKeyState[byte] |= mask;
+        } else {
+            this.currentPressedKeyState[byte] &= ~mask;
+        }
+        if (this.inputState !== undefined) {
+            this.#syncViews();
+            this.u8[this.inputState + INPUT_CURRENT_KEY_STATE + byte] = this.currentPressedKeyState[byte];
+        }
+    }
+
+    // Queues an event for GetKeyPressed()/GetCharPressed() of the builds that share their input
+    // state with us. The queue is emptied at the end of every frame.
+    #pushInputEvent(time, type, value) {
+        if (this.worker !== undefined) {
+            // The page side of the blocking mode, see #presentFrame()
+            if (this.ringEvents.length < INPUT_MAX_EVENTS) {
+                this.ringEventSerial += 1;
+                this.ringEvents.push({serial: this.ringEventSerial, time: performance.timeOrigin + time, type, value});
+            }
+            return;
+        }
+        if (this.inputState === undefined) return;
+        this.#syncViews();
+        const count = this.u32[(this.inputState + INPUT_EVENT_COUNT)>>2];
+        if (count >= INPUT_MAX_EVENTS) return;
+        const event = this.inputState + INPUT_EVENTS + count*INPUT_EVENT_SIZE;
+        this.f64[event>>3] = time;
+        this.i32[(event>>2) + 2] = type;
+        this.i32[(event>>2) + 3] = value;
+        this.u32[(this.inputState + INPUT_EVENT_COUNT)>>2] = count + 1;
+    }
+
+    // getBoundingClientRect() may force a synchronous layout, so the rect of the canvas is cached
+    // until a resize or scroll could have moved it.
+    #getCanvasRect() {
+        if (this.canvasRect === undefined) {
+            if (IS_WORKER) {
+                // NOTE: the page forwards the mouse positions already relative to the canvas
+                this.canvasRect = {left: 0, top: 0};
+            } else {
+                this.canvasRect = this.canvas.getBoundingClientRect();
+                this.frameLayoutReads += 1;
+            }
+        }
+        return this.canvasRect;
+    }
+
+    #invalidateCanvasRect() {
+        this.canvasRect = undefined;
+        this.mousePositionDirty = true;
+    }
+
+    // Recomputes the canvas relative mouse position once per frame, and only if the mouse or
+    // the canvas have moved since the previous one.
+    #updateMousePosition() {
+        if (!this.mousePositionDirty) return;
+        this.mousePositionDirty = false;
+        const bcrect = this.#getCanvasRect();
+        this.currentMousePosition.x = this.mouseClientX - bcrect.left;
+        this.currentMousePosition.y = this.mouseClientY - bcrect.top;
+        if (this.inputState !== undefined) {
+            this.#syncViews();
+            this.f32[(this.inputState + INPUT_MOUSE_POSITION)>>2]       = this.currentMousePosition.x;
+            this.f32[((this.inputState + INPUT_MOUSE_POSITION)>>2) + 1] = this.currentMousePosition.y;
+        }
+    }
+
+    stop() {
+        this.quit = true;
+        if (this.worker !== undefined) {
+            this.#stopWorker();
+            return;
+        }
+        // The scheduler may be suspended in the background, wake it up so it can clean up after us
+        RaylibJs.#reschedule();
+    }
+
+    // Options:
+    //   glyphAtlas    - draw text by blitting glyphs from prerendered atlases (see GlyphAtlas)
+    //                   instead of calling fillText()
+    //   fixedTimestep - run the game in fixed steps of 1/targetFPS, catching up with the real
+    //                   time by running several steps per tick if needed
+    //   backgroundFPS - the rate to run at while the canvas is hidden, 0 suspends the game
+    //   worker        - the path to raylib_worker.js, runs the game in a worker (start() only)
+    //   jspi          - run main() with its own game loop on JSPI (start() only)
+    //   preload       - load the assets before running the game (start() only): true finds them
+    //                   by running main() once more in a throwaway instance, an array lists
+    //                   their paths
+    async startExports({ exports, canvasId, canvas = document.getElementById(canvasId), glyphAtlas = false, fixedTimestep = false, backgroundFPS = 0 }) {
+        console.log(exports);
+
+        if (this.exports !== undefined) {
+            console.error("The game is already running. Please stop() it first.");
+            return;
+        }
+
+        this.canvas = canvas;
+        this.ctx = canvas.getContext("2d");
+        if (this.ctx === null) {
+            throw new Error("Could not create 2d canvas context");
+        }
+
+        this.exports = exports;
+        this.#syncViews();
+        if (glyphAtlas) this.glyphAtlases = new Map();
+        this.fixedTimestep = fixedTimestep;
+        this.backgroundFPS = backgroundFPS;
+        if (this.exports.raylib_js_command_buffer !== undefined) {
+            this.commandBuffer = this.exports.raylib_js_command_buffer();
+        }
+        if (this.exports.raylib_js_input_state !== undefined) {
+            this.inputState = this.exports.raylib_js_input_state();
+        }
+        if (this.exports.raylib_js_default_font !== undefined) {
+            this.defaultFont = new DefaultFontAtlas(this.exports.memory, this.exports.raylib_js_default_font());
+        }
+        if (this.exports.raylib_js_framebuffer !== undefined) {
+            this.framebuffer = this.exports.raylib_js_framebuffer();
+        }
+        if (this.exports.raylib_js_render_batch !== undefined) {
+            this.renderBatch = this.exports.raylib_js_render_batch();
+        }
+        if (this.exports.raylib_js_transform !== undefined) {
+            this.transformState = this.exports.raylib_js_transform();
+        }
+
+        this.pageVisible = IS_WORKER || !document.hidden;
+        const result = this.exports.main();
+        // With JSPI main() returns a promise that settles when it returns from its game loop. If
+        // that happens in a frame, the scheduler waiting for the frame learns about it.
+        if (result instanceof Promise) {
+            // The games that have set an entry keep running it after main() returns
+            const over = () => {
+                if (this.suspendsMain) this.entryFunction = () => {};
+            };
+            result.then(() => {
+                over();
+                this.frameDone?.resolve();
+                this.frameDone = undefined;
+            }, (e) => {
+                over();
+                if (this.frameDone !== undefined) {
+                    this.frameDone.reject(e);
+                    this.frameDone = undefined;
+                } else {
+                    console.error(e);
+                    this.stop();
+                }
+            });
+        }
+        RaylibJs.#register(this);
+    }
+
+    // All the instances on the page share a single scheduler driven by one requestAnimationFrame()
+    // chain and a single set of event listeners. Every frame runs the instances round-robin until
+    // RaylibJs.frameBudget milliseconds are spent, the ones that didn't fit go first next frame.
+    static frameBudget = 10;
+
+    // The fonts of all the instances share the page, so their families are numbered across them
+    static #fontFamilies = 0;
+    static #instances = [];
+    static #roundRobin = 0;
+    static #cancelTick = undefined;
+    static #running = false;
+    static #focused = undefined;
+    static #resizeObserver = undefined;
+    static #intersectionObserver = undefined;
+
+    static #register(instance) {
+        if (RaylibJs.#instances.length === 0) {
+            RaylibJs.#listen(true);
+        }
+        RaylibJs.#instances.push(instance);
+        instance.previous = performance.now();
+        instance.previousFrame = instance.previous;
+        if (!IS_WORKER) RaylibJs.#observe(instance.canvas);
+        instance.#updateVisibility();
+        RaylibJs.#reschedule();
+    }
+
+    // In a worker the visibility of the canvas is forwarded by the page and its layout is of no
+    // concern, as the page forwards the mouse positions already relative to the canvas.
+    static #observe(canvas) {
+        if (RaylibJs.#resizeObserver === undefined) {
+            RaylibJs.#resizeObserver = new ResizeObserver((entries) => {
+                for (const entry of entries) {
+                    for (const instance of RaylibJs.#instancesOf(entry.target)) instance.#invalidateCanvasRect();
+                }
+            });
+            RaylibJs.#intersectionObserver = new IntersectionObserver((entries) => {
+                for (const entry of entries) {
+                    for (const instance of RaylibJs.#instancesOf(entry.target)) {
+                        instance.onScreen = entry.isIntersecting;
+                        instance.#updateVisibility();
+                    }
+                }
+            });
+        }
+        RaylibJs.#resizeObserver.observe(canvas);
+        RaylibJs.#intersectionObserver.observe(canvas);
+    }
+
+    #unregister() {
+        const instances = RaylibJs.#instances;
+        instances.splice(instances.indexOf(this), 1);
+        if (RaylibJs.#focused === this) RaylibJs.#focused = undefined;
+        if (instances.length === 0) RaylibJs.#listen(false);
+        if (IS_WORKER) return;
+        // NOTE: the next game may already be running on the same canvas
+        if (RaylibJs.#instancesOf(this.canvas).length === 0) {
+            RaylibJs.#resizeObserver.unobserve(this.canvas);
+            RaylibJs.#intersectionObserver.unobserve(this.canvas);
+        }
+        if (instances.length === 0) {
+            RaylibJs.#resizeObserver.disconnect();
+            RaylibJs.#intersectionObserver.disconnect();
+            RaylibJs.#resizeObserver = undefined;
+            RaylibJs.#intersectionObserver = undefined;
+        }
+    }
+
+    static #instancesOf(canvas) {
+        return RaylibJs.#instances.filter((instance) => instance.canvas === canvas);
+    }
+
+    static #listen(add) {
+        const method = add ? "addEventListener" : "removeEventListener";
+        font_face_set()[method]("loadingdone", RaylibJs.#onFontsLoaded);
+        if (IS_WORKER) return;
+        window[method]("keydown", RaylibJs.#onKeyDown);
+        window[method]("keyup", RaylibJs.#onKeyUp);
+        window[method]("wheel", RaylibJs.#onWheel);
+        window[method]("mousemove", RaylibJs.#onMouseMove);
+        window[method]("pointerdown", RaylibJs.#onPointerDown, {capture: true, passive: true});
+        // NOTE: scroll events don't bubble, capturing catches the scrolling of any container of the canvas
+        window[method]("scroll", RaylibJs.#onLayoutChange, {capture: true, passive: true});
+        window[method]("resize", RaylibJs.#onLayoutChange);
+        document[method]("visibilitychange", RaylibJs.#onVisibilityChange);
+    }
+
+    // The keyboard and the wheel go to the canvas that was clicked last, or to the most recently
+    // started game until any of them is.
+    static #inputTarget() {
+        if (RaylibJs.#focused !== undefined) return RaylibJs.#focused;
+        return RaylibJs.#instances[RaylibJs.#instances.length - 1];
+    }
+
+    static #onKeyDown = (e) => {
+        const target = RaylibJs.#inputTarget();
+        if (target !== undefined) target.#keyDown(e);
+    };
+    static #onKeyUp = (e) => {
+        const target = RaylibJs.#inputTarget();
+        if (target !== undefined) target.#keyUp(e);
+    };
+    static #onWheel = (e) => {
+        const target = RaylibJs.#inputTarget();
+        if (target !== undefined) target.#wheelMove(e);
+    };
+    static #onMouseMove = (e) => {
+        for (const instance of RaylibJs.#instances) instance.#mouseMove(e);
+    };
+    static #onPointerDown = (e) => {
+        const instances = RaylibJs.#instancesOf(e.target);
+        if (instances.length === 0) return;
+        const focused = instances[instances.length - 1];
+        const previous = RaylibJs.#inputTarget();
+        if (focused === previous) return;
+        // The keys held down now will be released over there
+        previous.#releaseKeys();
+        RaylibJs.#focused = focused;
+    };
+    static #onLayoutChange = () => {
+        for (const instance of RaylibJs.#instances) instance.#invalidateCanvasRect();
+    };
+    static #onVisibilityChange = () => {
+        for (const instance of RaylibJs.#instances) {
+            instance.pageVisible = !document.hidden;
+            instance.#updateVisibility();
+        }
+    };
+    static #onFontsLoaded = () => {
+        for (const instance of RaylibJs.#instances) instance.#fontsChanged();
+    };
+
+    // NOTE: the browsers don't call requestAnimationFrame() in the background tabs at all, so
+    // the background ticks are driven by a timer. Its timestamps come from the same clock.
+    static #schedule() {
+        const instances = RaylibJs.#instances;
+        if (RaylibJs.#cancelTick !== undefined || RaylibJs.#running || instances.length === 0) return;
+        const run = () => RaylibJs.#run(performance.now());
+        // The games running in workers are driven by the schedulers over there
+        const local = instances.filter((instance) => instance.#runsHere());
+        if (local.length === 0) return;
+        if (local.some((instance) => instance.quit)) {
+            const id = setTimeout(run, 0);
+            RaylibJs.#cancelTick = () => clearTimeout(id);
+        } else if (local.some((instance) => instance.visible)) {
+            const id = requestAnimationFrame(RaylibJs.#run);
+            RaylibJs.#cancelTick = () => cancelAnimationFrame(id);
+        } else {
+            const fps = Math.max(...local.map((instance) => instance.backgroundFPS));
+            if (fps > 0) {
+                const id = setTimeout(run, 1000/fps);
+                RaylibJs.#cancelTick = () => clearTimeout(id);
+            }
+            // Otherwise everything is suspended until something becomes visible again
+        }
+    }
+
+    static #reschedule() {
+        if (RaylibJs.#cancelTick !== undefined) RaylibJs.#cancelTick();
+        RaylibJs.#cancelTick = undefined;
+        RaylibJs.#schedule();
+    }
+
+    // The frames of the games on JSPI run when their main() is resumed, so they are waited for
+    // before the next game goes. Nothing else is scheduled in the meantime.
+    static #run = async (timestamp) => {
+        RaylibJs.#cancelTick = undefined;
+        RaylibJs.#running = true;
+        for (const instance of RaylibJs.#instances.filter((instance) => instance.quit && instance.worker === undefined)) {
+            instance.ctx.clearRect(0, 0, instance.ctx.canvas.width, instance.ctx.canvas.height);
+            instance.#unregister();
+            instance.#unloadAll();
+            instance.#reset();
+        }
+
+        const instances = RaylibJs.#instances.filter((instance) => instance.#runsHere());
+        const start = performance.now();
+        const first = RaylibJs.#roundRobin;
+        RaylibJs.#roundRobin = instances.length > 0 ? (first + 1)%instances.length : 0;
+        for (let i = 0; i < instances.length; ++i) {
+            const instance = instances[(first + i)%instances.length];
+            if (i > 0 && performance.now() - start >= RaylibJs.frameBudget) {
+                // Out of time. The rest of them go first on the next frame.
+                RaylibJs.#roundRobin = (first + i)%instances.length;
+                for (let j = i; j < instances.length; ++j) {
+                    const skipped = instances[(first + j)%instances.length];
+                    if (skipped.visible) skipped.stats.budgetSkippedTicks += 1;
+                }
+                break;
+            }
+            try {
+                const frame = instance.#tick(timestamp);
+                if (frame !== undefined) await frame;
+            } catch (e) {
+                // Don't let a single broken game take down the rest of the page
+                console.error(e);
+                instance.quit = true;
+            }
+        }
+        RaylibJs.#running = false;
+        RaylibJs.#schedule();
+    };
+
+    // The handlers of the events translate them into the calls below, which are forwarded as is
+    // to the worker in the worker mode. -1 stands for no key or no character.
+    // The worker of the blocking mode never gets to process the messages, the page presenting its
+    // frames handles the input for it instead.
+    #forwardsInput() {
+        return this.worker !== undefined && this.ring === undefined;
+    }
+
+    // Whether the scheduler on this thread runs the frames of the game
+    #runsHere() {
+        return this.worker === undefined || this.ring !== undefined;
+    }
+
+    #keyDown(e) {
+        // NOTE: e.key is the name of the key unless it produces a single character
+        const char = e.key.codePointAt(0);
+        const isChar = e.key.length === (char > 0xFFFF ? 2 : 1);
+        this.#pressKey(glfwKeyMapping[e.code] ?? -1, isChar ? char : -1, e.repeat, e.timeStamp);
+    }
+
+    #keyUp(e) {
+        this.#releaseKey(glfwKeyMapping[e.code] ?? -1);
+    }
+
+    #wheelMove(e) {
+        this.#setMouseWheelMove(Math.sign(-e.deltaY));
+    }
+
+    #mouseMove(e) {
+        if (this.#forwardsInput()) {
+            const bcrect = this.#getCanvasRect();
+            this.worker.postMessage([WORKER_MOUSE_MOVE, e.clientX - bcrect.left, e.clientY - bcrect.top]);
+            return;
+        }
+        this.#moveMouse(e.clientX, e.clientY);
+    }
+
+    #pressKey(key, char, repeat, time) {
+        if (this.#forwardsInput()) {
+            // NOTE: the clocks of the page and the worker start at different times
+            this.worker.postMessage([WORKER_KEY_DOWN, key, char, repeat, performance.timeOrigin + time]);
+            return;
+        }
+        if (key >= 0) {
+            this.#setKeyState(key, true);
+            if (!repeat) this.#pushInputEvent(time, INPUT_EVENT_KEY, key);
+        }
+        if (char >= 0) this.#pushInputEvent(time, INPUT_EVENT_CHAR, char);
+    }
+
+    #releaseKey(key) {
+        if (this.#forwardsInput()) {
+            this.worker.postMessage([WORKER_KEY_UP, key]);
+            return;
+        }
+        if (key >= 0) this.#setKeyState(key, false);
+    }
+
+    #setMouseWheelMove(move) {
+        if (this.#forwardsInput()) {
+            this.worker.postMessage([WORKER_MOUSE_WHEEL, move]);
+            return;
+        }
+        this.currentMouseWheelMoveState = move;
+        if (this.inputState !== undefined) {
+            this.#syncViews();
+            this.f32[(this.inputState + INPUT_MOUSE_WHEEL_MOVE)>>2] = this.currentMouseWheelMoveState;
+        }
+    }
+
+    #moveMouse(x, y) {
+        this.mouseClientX = x;
+        this.mouseClientY = y;
+        this.mousePositionDirty = true;
+    }
+
+    #releaseKeys() {
+        if (this.#forwardsInput()) {
+            this.worker.postMessage([WORKER_RELEASE_KEYS]);
+            return;
+        }
+        this.currentPressedKeyState.fill(0);
+        if (this.inputState !== undefined) {
+            this.#syncViews();
+            const begin = this.inputState + INPUT_CURRENT_KEY_STATE;
+            this.u8.fill(0, begin, begin + INPUT_MAX_KEYS/8);
+        }
+    }
+
+    // The canvas is visible when its page is and it's scrolled into view
+    #updateVisibility() {
+        const visible = this.pageVisible && this.onScreen;
+        if (visible === this.visible) return;
+        this.visible = visible;
+        if (this.#forwardsInput()) this.worker.postMessage([WORKER_VISIBILITY, visible]);
+        if (visible) {
+            this.resuming = true;
+        } else {
+            this.hiddenSince = performance.now();
+            this.hiddenFrames = 0;
+        }
+        RaylibJs.#reschedule();
+    }
+
+    // Called on every animation frame of the browser. The browser runs them at the refresh rate of
+    // the display, so to stick to the target FPS on 120/144Hz displays some of them are skipped.
+    // Hidden canvases run at backgroundFPS instead, or not at all.
+    #tick(timestamp) {
+        // main() of a game on JSPI is still waiting for its textures
+        if (this.entryFunction === undefined) return;
+        const targetInterval = this.targetFPS > 0 ? 1000/this.targetFPS : 0;
+        if (this.resuming) {
+            // Account for the frames we didn't run in the background and pick up from here as if
+            // nothing happened. Otherwise the first frame gets the whole time we were hidden as dt.
+            const expected = targetInterval > 0 ? Math.floor((timestamp - this.hiddenSince)/targetInterval) : 0;
+            this.stats.hiddenSkippedFrames += Math.max(expected - this.hiddenFrames, 0);
+            this.resuming = false;
+            this.previous = timestamp - targetInterval;
+            this.previousFrame = timestamp - targetInterval;
+            this.accumulator = 0;
+        }
+        if (!this.visible && this.backgroundFPS <= 0) return;
+        const fps = this.visible ? this.targetFPS : this.backgroundFPS;
+        const interval = fps > 0 ? 1000/fps : 0;
+
+        const elapsed = timestamp - this.previous;
+        // The timestamps jitter a bit, so a tick that comes slightly early still counts
+        if (elapsed < interval - FRAME_PACING_TOLERANCE_MS) {
+            this.stats.pacingSkippedTicks += 1;
+            return;
+        }
+        // Stay on the cadence of the target rate instead of drifting by whatever we overshot it
+        this.previous = elapsed > interval && interval > 0 ? timestamp - elapsed%interval : timestamp;
+        if (!this.visible) this.hiddenFrames += 1;
+
+        const dt = Math.min((timestamp - this.previousFrame)/1000.0, MAX_FRAME_TIME);
+        this.previousFrame = timestamp;
+        this.frameTimes[this.frameTimesIndex] = dt;
+        this.frameTimesIndex = (this.frameTimesIndex + 1)%FPS_CAPTURE_FRAMES_COUNT;
+        this.#updateMousePosition();
+
+        if (!this.fixedTimestep || this.targetFPS <= 0) {
+            this.dt = dt;
+            // The frame of a game on JSPI is done when the promise is
+            return this.entryFunction();
+        }
+
+        const step = 1.0/this.targetFPS;
+        this.accumulator += dt;
+        let steps = 0;
+        while (this.accumulator >= step && steps < MAX_FIXED_STEPS_PER_TICK) {
+            this.dt = step;
+            this.entryFunction();
+            this.accumulator -= step;
+            steps += 1;
+        }
+        if (this.accumulator >= step) {
+            // We can't keep up. Drop the time we are behind instead of spiraling.
+            this.stats.droppedSteps += Math.floor(this.accumulator/step);
+            this.accumulator %= step;
+        }
+    }
+
+    async start({ wasmPath, canvasId, worker, jspi = false, preload = false, ...options }) {
+        if (worker !== undefined) {
+            this.#startWorker(worker, wasmPath, canvasId, {jspi, preload, ...options});
+            return;
+        }
+        if (jspi && WebAssembly.Suspending === undefined) {
+            throw new Error("This browser does not support JavaScript Promise Integration (WebAssembly.Suspending)");
+        }
+        const module = await WebAssembly.compileStreaming(fetch(wasmPath));
+        if (preload) await this.#preload(module, preload);
+        const env = make_environment(this);
+        const instance = await WebAssembly.instantiate(module, {
+            env: jspi ? this.#suspendingEnvironment(env) : env
+        });
+        this.jspi = jspi;
+
+        let exports = instance.exports;
+        if (jspi) {
+            exports = {...exports, main: WebAssembly.promising(exports.main)};
+            if (options.fixedTimestep) {
+                console.warn("fixedTimestep is not supported with jspi, a suspended main() can only run one frame per tick");
+                options.fixedTimestep = false;
+            }
+        }
+        this.startExports( {
+            exports,
+            canvasId,
+            ...options,
+        })
+    }
+
+    // Loads the assets of the game before running it. By the time the game asks for them they are
+    // ready, so its textures have their real size and its first frame draws everything. The paths
+    // are either listed in the manifest, or found by running main() of a throwaway instance of the
+    // game up to its first frame. The latter runs every side effect of main() twice.
+    async #preload(module, manifest) {
+        const assets = Array.isArray(manifest)
+            ? manifest.map((path) => ({kind: /\.(ttf|otf|woff2?)$/i.test(path) ? "font" : "texture", path}))
+            : await this.#scoutAssets(module);
+        await Promise.all(assets.map(async ({kind, path}) => {
+            try {
+                if (kind === "texture") {
+                    const decoded = await this.#decodeTexture(path).ready;
+                    this.assets.push({kind, path, width: decoded.bitmap.width, height: decoded.bitmap.height, fetchTime: decoded.fetchTime, decodeTime: decoded.decodeTime});
+                } else {
+                    const start = performance.now();
+                    await this.#fontFace(path).face.load();
+                    this.assets.push({kind, path, fetchTime: performance.now() - start, decodeTime: 0});
+                }
+            } catch (e) {
+                console.error(`Could not preload ${path}`, e);
+            }
+        }));
+        for (const asset of this.assets) {
+            const size = asset.kind === "texture" ? ` (${asset.width}x${asset.height})` : "";
+            console.log(`INFO: PRELOAD: ${asset.path}${size} fetched in ${asset.fetchTime.toFixed(1)} ms, decoded in ${asset.decodeTime.toFixed(1)} ms`);
+        }
+    }
+
+    // Runs main() of a throwaway instance of the game up to its first frame and returns the assets
+    // it loads there
+    async #scoutAssets(module) {
+        const scout = new RaylibJs();
+        scout.scouting = [];
+        scout.ctx = new OffscreenCanvas(1, 1).getContext("2d");
+        const instance = await WebAssembly.instantiate(module, {
+            env: make_environment(scout)
+        });
+        scout.exports = instance.exports;
+        try {
+            instance.exports.main();
+            // The games that have set an entry load the rest of their assets in the first frame
+            if (scout.entryFunction !== undefined) scout.entryFunction();
+        } catch (e) {
+            // Whatever went wrong will go wrong again for real, we just stop looking
+            if (e !== SCOUTING_DONE) console.warn("Could not look for the assets to preload", e);
+        }
+        return scout.scouting;
+    }
+
+    // The textures loaded from the same path share the decoded image. It's closed once the last
+    // of them is unloaded, unless nothing has loaded it yet because it was only preloaded.
+    #decodeTexture(path) {
+        let decoded = this.decoded.get(path);
+        if (decoded === undefined) {
+            decoded = {bitmap: undefined, refs: 0, fetchTime: 0, decodeTime: 0};
+            decoded.ready = ImageDecoderPool.shared().decode(asset_url(path)).then((result) => {
+                if (this.decoded.get(path) !== decoded) {
+                    // Unloaded while it was being decoded
+                    result.bitmap.close();
+                    return decoded;
+                }
+                Object.assign(decoded, result);
+                this.stats.textureBytes += bitmap_bytes(result.bitmap);
+                return decoded;
+            }, (e) => {
+                this.decoded.delete(path);
+                throw e;
+            });
+            this.decoded.set(path, decoded);
+        }
+        return decoded;
+    }
+
+    #releaseDecoded(path) {
+        const decoded = this.decoded.get(path);
+        if (decoded === undefined || --decoded.refs > 0) return;
+        this.decoded.delete(path);
+        if (decoded.bitmap !== undefined) this.#closeBitmap(decoded.bitmap);
+    }
+
+    #closeBitmap(bitmap) {
+        this.stats.textureBytes -= bitmap_bytes(bitmap);
+        bitmap.close();
+    }
+
+    // Returns the texture with the decoded image, or the one that gets it once it's decoded
+    #loadTexture(path) {
+        const decoded = this.#decodeTexture(path);
+        decoded.refs += 1;
+        const texture = {path, bitmap: decoded.bitmap};
+        if (texture.bitmap === undefined) {
+            // NOTE: not preloaded, so it's not drawn and we don't know its size until it's decoded
+            decoded.ready.then((decoded) => texture.bitmap = decoded.bitmap, (e) => console.error(`Could not load ${path}`, e));
+        }
+        return texture;
+    }
+
+    #unloadTexture(id) {
+        const texture = this.textures.remove(id);
+        if (texture === undefined) return;
+        this.stats.textures = this.textures.count;
+        this.tintCache.forget(id);
+        if (this.framebuffer !== undefined) this.exports.raylib_js_software_unbind_texture(id);
+        if (IS_WORKER && this.ring !== undefined) {
+            // NOTE: the frames that are still in the ring are drawn without it
+            postMessage([WORKER_UNLOAD_TEXTURE, id]);
+        } else if (texture.path !== undefined) {
+            this.#releaseDecoded(texture.path);
+        } else if (texture.pixels !== undefined) {
+            // NOTE: the software renderer keeps the pixels in the linear memory
+            if (texture.bitmap !== undefined) this.stats.textureBytes -= bitmap_bytes(texture.bitmap);
+        } else if (texture.ctx !== undefined) {
+            // The pixels the page got from the worker of the blocking mode
+            this.stats.textureBytes -= bitmap_bytes(texture.bitmap);
+            release_canvas(texture.bitmap);
+        } else if (texture.bitmap !== undefined) {
+            // The copy the page got from the worker of the blocking mode
+            this.#closeBitmap(texture.bitmap);
+        }
+    }
+
+    // The fonts loaded from the same path share the face, which is removed from the page once the
+    // last of them is unloaded. Every path gets a family of its own.
+    #fontFace(path) {
+        let font = this.fontFaces.get(path);
+        if (font === undefined) {
+            const family = `raylib-font-${++RaylibJs.#fontFamilies}`;
+            font = {face: new FontFace(family, `url(${asset_url(path)})`), family, refs: 0};
+            font.face.load().then(() => this.#fontsChanged(), (e) => console.error(`Could not load ${path}`, e));
+            font_face_set().add(font.face);
+            this.fontFaces.set(path, font);
+        }
+        return font;
+    }
+
+    #loadFont(path) {
+        const font = this.#fontFace(path);
+        font.refs += 1;
+        return {path, family: font.family};
+    }
+
+    #unloadFont(id) {
+        const font = this.fonts.remove(id);
+        if (font === undefined) return;
+        this.stats.fonts = this.fonts.count;
+        if (IS_WORKER && this.ring !== undefined) postMessage([WORKER_UNLOAD_FONT, id]);
+        const face = this.fontFaces.get(font.path);
+        if (face === undefined || --face.refs > 0) return;
+        this.fontFaces.delete(font.path);
+        font_face_set().delete(face.face);
+        this.#fontsChanged();
+    }
+
+    // Lets go of everything the game has not unloaded itself when it stops
+    #unloadAll() {
+        this.tintCache.clear();
+        for (const texture of this.textures.values()) {
+            if (texture.path === undefined && texture.pixels === undefined && texture.bitmap !== undefined) this.#closeBitmap(texture.bitmap);
+        }
+        for (const decoded of this.decoded.values()) {
+            if (decoded.bitmap !== undefined) this.#closeBitmap(decoded.bitmap);
+        }
+        for (const font of this.fontFaces.values()) font_face_set().delete(font.face);
+    }
+
+    // The family of the font with the id, or the default one
+    #fontFamily(id) {
+        return this.fonts.get(id)?.family ?? "grixel";
+    }
+
+    // With JSPI, EndDrawing() suspends main() until the scheduler runs the next frame, which just
+    // resumes it. So main() can have a game loop like it would natively, without the code size and
+    // speed cost of transforming it with Asyncify. LoadTexture() suspends it until the image is
+    // decoded, so the texture has its real size.
+    #suspendingEnvironment(env) {
+        const endDrawing = new WebAssembly.Suspending(() => {
+            this.EndDrawing();
+            // The games that have set an entry with raylib_js_set_entry() are called every frame
+            // as usual. Not suspending lets them return.
+            if (this.entryFunction !== undefined && !this.suspendsMain) return;
+            this.suspendsMain = true;
+            // The frame the scheduler is waiting for is over, the next one resumes main()
+            this.frameDone?.resolve();
+            this.frameDone = undefined;
+            return new Promise((resume) => {
+                this.entryFunction = () => new Promise((resolve, reject) => {
+                    this.frameDone = {resolve, reject};
+                    resume();
+                });
+            });
+        });
+        const loadTexture = new WebAssembly.Suspending((result_ptr, filename_ptr) => {
+            // Only main() waits before its first frame. Waiting in a frame would hold up the
+            // scheduler and every other game on the page.
+            const suspendable = this.entryFunction === undefined;
+            this.#syncViews();
+            const filename = cstr_by_ptr(this.u8, filename_ptr);
+            if (!suspendable || this.decoded.get(filename)?.bitmap !== undefined) {
+                this.LoadTexture(result_ptr, filename_ptr);
+                return;
+            }
+            // NOTE: a failed decode is logged by LoadTexture() trying again
+            const load = () => { this.LoadTexture(result_ptr, filename_ptr); };
+            return this.#decodeTexture(filename).ready.then(load, load);
+        });
+        const suspending = {EndDrawing: endDrawing, LoadTexture: loadTexture};
+        return new Proxy(env, {
+            get(target, prop) {
+                return suspending[prop] ?? target[prop];
+            }
+        });
+    }
+
+    // In the worker mode the game runs in a Worker that owns the canvas and draws to it directly,
+    // so neither the page can delay its frames nor can its frames delay the page. The RaylibJs on
+    // the page only forwards the input and the visibility of the canvas to the one in the worker.
+    //
+    // In the blocking variant of it the worker runs main() with the usual game loop of raylib
+    // instead. The page keeps the canvas and draws the frames the game publishes into a FrameRing,
+    // which also carries the input back.
+    #startWorker(workerPath, wasmPath, canvasId, { blocking = false, ...options }) {
+        if (this.exports !== undefined || this.worker !== undefined) {
+            console.error("The game is already running. Please stop() it first.");
+            return;
+        }
+        if (blocking && !globalThis.crossOriginIsolated) {
+            throw new Error("The blocking mode needs SharedArrayBuffer. Please serve the page with the headers `Cross-Origin-Opener-Policy: same-origin` and `Cross-Origin-Embedder-Policy: require-corp`.");
+        }
+        this.canvas = document.getElementById(canvasId);
+        this.worker = new Worker(workerPath);
+        this.worker.onmessage = (e) => this.#onWorkerMessage(e.data);
+        // NOTE: relative paths would be resolved against the location of the worker script
+        wasmPath = new URL(wasmPath, document.baseURI).href;
+        if (blocking) {
+            this.ctx = this.canvas.getContext("2d");
+            this.ring = FrameRing.create();
+            this.u8 = this.ring.u8;
+            this.u32 = this.ring.u32;
+            this.i32 = this.ring.i32;
+            this.f32 = this.ring.f32;
+            this.entryFunction = () => this.#presentFrame();
+            this.worker.postMessage([WORKER_START_BLOCKING, wasmPath, this.ring.buffer, options]);
+        } else {
+            const offscreen = this.canvas.transferControlToOffscreen();
+            this.worker.postMessage([WORKER_START, wasmPath, offscreen, options], [offscreen]);
+        }
+        this.pageVisible = !document.hidden;
+        RaylibJs.#register(this);
+    }
+
+    #stopWorker() {
+        this.worker.terminate();
+        if (this.ring !== undefined) {
+            this.ctx.clearRect(0, 0, this.canvas.width, this.canvas.height);
+        } else {
+            // The control over a canvas can be transferred only once, so the next game gets a new one
+            const canvas = this.canvas.cloneNode();
+            this.canvas.replaceWith(canvas);
+        }
+        this.#unregister();
+        this.#unloadAll();
+        this.#reset();
+    }
+
+    // Runs on the page in the blocking mode
+    #presentFrame() {
+        const ring = this.ring;
+        this.targetFPS = ring.targetFPS();
+        const ack = ring.inputAck();
+        while (this.ringEvents.length > 0 && this.ringEvents[0].serial <= ack) this.ringEvents.shift();
+        ring.writeInput(this.currentPressedKeyState, this.currentMousePosition, this.currentMouseWheelMoveState, this.ringEvents);
+        this.currentMouseWheelMoveState = 0;
+        ring.present((begin, end) => this.#executeCommands(begin, end));
+    }
+
+    // Runs in the worker of the blocking mode. The loop of the game never gives the control back, so
+    // nothing asynchronous ever completes in here. Whatever has to load is loaded by the page.
+    async #startBlocking(wasmPath, buffer, { preload = false }) {
+        const module = await WebAssembly.compileStreaming(fetch(wasmPath));
+        if (preload) await this.#preload(module, preload);
+        const instance = await WebAssembly.instantiate(module, {
+            env: make_environment(this)
+        });
+        this.exports = instance.exports;
+        if (this.exports.raylib_js_command_buffer === undefined) {
+            throw new Error("The blocking mode needs the game to be built with -DRAYLIB_JS_COMMAND_BUFFER");
+        }
+        this.#syncViews();
+        this.ring = new FrameRing(buffer);
+        // Only to measure the text with, the page does the drawing
+        this.canvas = new OffscreenCanvas(1, 1);
+        this.ctx = this.canvas.getContext("2d");
+        this.commandBuffer = this.exports.raylib_js_command_buffer();
+        const capacity = this.u32[(this.commandBuffer>>2) + 1];
+        if (capacity > this.ring.slotCapacity) {
+            // Built with a bigger RAYLIB_JS_COMMAND_BUFFER_CAPACITY. Nothing is published yet, so
+            // the page can still switch to a ring with slots that fit it.
+            this.ring = FrameRing.create(capacity);
+            postMessage([WORKER_RING, this.ring.buffer]);
+        }
+        if (this.exports.raylib_js_input_state !== undefined) {
+            this.inputState = this.exports.raylib_js_input_state();
+        }
+        if (this.exports.raylib_js_render_batch !== undefined) {
+            // Recorded into the commands, so it goes through the ring with them
+            this.renderBatch = this.exports.raylib_js_render_batch();
+        }
+        if (this.exports.raylib_js_transform !== undefined) {
+            this.transformState = this.exports.raylib_js_transform();
+        }
+        if (this.exports.raylib_js_default_font !== undefined) {
+            const font = this.exports.raylib_js_default_font();
+            const [, glyphCount, width, height] = this.i32.subarray(font>>2, (font>>2) + 4);
+            postMessage([WORKER_DEFAULT_FONT, this.u8.slice(font, font + 16 + width*height/8 + glyphCount*16)]);
+        }
+        this.dt = 0;
+        this.previousFrame = performance.now();
+        this.exports.main();
+        // The games written for the other modes return from main() right away
+        while (this.entryFunction !== undefined && !this.WindowShouldClose()) this.entryFunction();
+    }
+
+    // Called at the end of every frame in the worker of the blocking mode
+    #publishFrame() {
+        this.ring.publish(true);
+        const now = performance.now();
+        this.dt = Math.min((now - this.previousFrame)/1000.0, MAX_FRAME_TIME);
+        this.previousFrame = now;
+        this.frameTimes[this.frameTimesIndex] = this.dt;
+        this.frameTimesIndex = (this.frameTimesIndex + 1)%FPS_CAPTURE_FRAMES_COUNT;
+
+        const input = this.ring.readInput(this.ringInputSeq);
+        if (input === undefined) return;
+        this.ringInputSeq = input.seq;
+        this.currentPressedKeyState.set(input.keys);
+        if (this.inputState !== undefined) {
+            this.#syncViews();
+            this.u8.set(input.keys, this.inputState + INPUT_CURRENT_KEY_STATE);
+        }
+        this.#moveMouse(input.x, input.y);
+        this.#updateMousePosition();
+        if (input.wheel !== 0) this.#setMouseWheelMove(input.wheel);
+        for (const event of input.events) {
+            if (event.serial <= this.ringEventSerial) continue;
+            this.#pushInputEvent(event.time - performance.timeOrigin, event.type, event.value);
+            this.ringEventSerial = event.serial;
+        }
+        this.ring.ackInput(this.ringEventSerial);
+    }
+
+    // Entry point of raylib_worker.js
+    static runWorker() {
+        const raylibJs = new RaylibJs();
+        self.onmessage = (e) => raylibJs.#onWorkerMessage(e.data);
+    }
+
+    #onWorkerMessage(message) {
+        switch (message[0]) {
+            case WORKER_START: {
+                const [, wasmPath, canvas, options] = message;
+                this.start({wasmPath, canvas, ...options});
+            } break;
+            case WORKER_START_BLOCKING: {
+                const [, wasmPath, buffer, options] = message;
+                this.#startBlocking(wasmPath, buffer, options);
+            } break;
+            case WORKER_KEY_DOWN: {
+                const [, key, char, repeat, time] = message;
+                this.#pressKey(key, char, repeat, time - performance.timeOrigin);
+            } break;
+            case WORKER_KEY_UP:       this.#releaseKey(message[1]); break;
+            case WORKER_RELEASE_KEYS: this.#releaseKeys(); break;
+            case WORKER_MOUSE_MOVE:   this.#moveMouse(message[1], message[2]); break;
+            case WORKER_MOUSE_WHEEL:  this.#setMouseWheelMove(message[1]); break;
+            case WORKER_VISIBILITY: {
+                this.onScreen = message[1];
+                this.#updateVisibility();
+            } break;
+            case WORKER_INIT_WINDOW: {
+                const [, width, height, title] = message;
+                document.title = title;
+                // Otherwise the canvas belongs to the worker
+                if (this.ring !== undefined) {
+                    this.canvas.width = width;
+                    this.canvas.height = height;
+                    this.ctxState = {};
+                    this.transform = [1, 0, 0, 1, 0, 0];
+                    this.#invalidateCanvasRect();
+                }
+            } break;
+            case WORKER_LOAD_TEXTURE: {
+                const [, id, url, bitmap] = message;
+                if (bitmap !== undefined) {
+                    this.stats.textureBytes += bitmap_bytes(bitmap);
+                    this.textures.put(id, {path: undefined, bitmap});
+                } else {
+                    this.textures.put(id, this.#loadTexture(url));
+                }
+                this.stats.textures = this.textures.count;
+            } break;
+            case WORKER_UNLOAD_TEXTURE: this.#unloadTexture(message[1]); break;
+            case WORKER_LOAD_FONT: {
+                const [, id, url] = message;
+                this.fonts.put(id, this.#loadFont(url));
+                this.stats.fonts = this.fonts.count;
+            } break;
+            case WORKER_UNLOAD_FONT: this.#unloadFont(message[1]); break;
+            case WORKER_DEFAULT_FONT: {
+                this.defaultFont = new DefaultFontAtlas({buffer: message[1].buffer}, 0);
+            } break;
+            case WORKER_LOAD_PIXELS: {
+                const [, id, width, height, pixels] = message;
+                const bitmap = new OffscreenCanvas(width, height);
+                const texture = {path: undefined, bitmap, ctx: bitmap.getContext("2d"), version: 0};
+                texture.ctx.putImageData(new ImageData(pixels, width, height), 0, 0);
+                this.textures.put(id, texture);
+                this.stats.textures = this.textures.count;
+                this.stats.textureBytes += bitmap_bytes(bitmap);
+            } break;
+            case WORKER_UPDATE_PIXELS: {
+                const [, id, x, y, width, height, pixels] = message;
+                const texture = this.textures.get(id);
+                if (texture?.ctx === undefined) break;
+                texture.ctx.putImageData(new ImageData(pixels, width, height), x, y);
+                texture.version += 1;
+            } break;
+            case WORKER_RING: {
+                this.ring = new FrameRing(message[1]);
+                this.u8 = this.ring.u8;
+                this.u32 = this.ring.u32;
+                this.i32 = this.ring.i32;
+                this.f32 = this.ring.f32;
+            } break;
+            default: console.error(`Unknown worker message ${message[0]}`);
+        }
+    }
+
+    InitWindow(width, height, title_ptr) {
+        this.startTime = performance.now();
+        this.ctx.canvas.width = width;
+        this.ctx.canvas.height = height;
+        // Resizing the canvas resets the state of its context
+        this.ctxState = {};
+        this.transform = [1, 0, 0, 1, 0, 0];
+        this.transformVersion = undefined;
+        this.#invalidateCanvasRect();
+        this.#syncViews();
+        if (this.framebuffer !== undefined) this.#resizeFramebuffer(width, height);
+        if (this.transformState !== undefined) {
+            this.i32[(this.transformState + TRANSFORM_SCREEN_WIDTH)>>2] = width;
+            this.i32[(this.transformState + TRANSFORM_SCREEN_HEIGHT)>>2] = height;
+        }
+        const title = cstr_by_ptr(this.u8, title_ptr);
+        if (this.scouting !== undefined) {
+            // The window is not really there yet
+        } else if (IS_WORKER) {
+            postMessage([WORKER_INIT_WINDOW, width, height, title]);
+        } else {
+            document.title = title;
+        }
+    }
+
+    WindowShouldClose(){
+        return this.quit;
+    }
+
+    CloseWindow() {}
+
+    SetTargetFPS(fps) {
+        this.targetFPS = fps;
+        this.accumulator = 0;
+        if (this.ring !== undefined) this.ring.setTargetFPS(fps);
+    }
+
+    GetScreenWidth() {
+        return this.ctx.canvas.width;
+    }
+
+    GetScreenHeight() {
+        return this.ctx.canvas.height;
+    }
+
+    GetFrameTime() {
+        return this.dt;
+    }
+
+    // RLAPI double GetTime(void);                                   // Get elapsed time in seconds since InitWindow()
+    GetTime() {
+        return (performance.now() - this.startTime)/1000.0;
+    }
+
+    // RLAPI int GetFPS(void);                                       // Get current FPS
+    GetFPS() {
+        let total = 0;
+        for (let i = 0; i < FPS_CAPTURE_FRAMES_COUNT; ++i) total += this.frameTimes[i];
+        return total > 0 ? Math.round(FPS_CAPTURE_FRAMES_COUNT/total) : 0;
+    }
+
+    BeginDrawing() {}
+
+    EndDrawing() {
+        if (this.scouting !== undefined) throw SCOUTING_DONE;
+        if (this.renderBatch !== undefined) this.#flushBatch();
+        if (this.commandBuffer !== undefined) this.raylib_js_flush_commands();
+        if (this.layerTarget !== undefined) this.#endLayer();
+        if (this.framebuffer !== undefined) this.#presentFramebuffer();
+        this.stats.stateChangesSkipped += this.frameStateChangesSkipped;
+        this.stats.lastFrameStateChangesSkipped = this.frameStateChangesSkipped;
+        this.frameStateChangesSkipped = 0;
+        this.stats.layoutReads += this.frameLayoutReads;
+        this.stats.lastFrameLayoutReads = this.frameLayoutReads;
+        this.frameLayoutReads = 0;
+        if (this.transformState !== undefined) {
+            this.#syncViews();
+            this.stats.culledDraws += this.u32[(this.transformState + TRANSFORM_CULLED)>>2];
+            this.u32[(this.transformState + TRANSFORM_CULLED)>>2] = 0;
+        }
+        this.prevPressedKeyState.set(this.currentPressedKeyState);
+        this.currentMouseWheelMoveState = 0.0;
+        if (this.inputState !== undefined) {
+            this.#syncViews();
+            const state = this.inputState;
+            this.u8.set(this.currentPressedKeyState, state + INPUT_PREVIOUS_KEY_STATE);
+            this.f32[(state + INPUT_MOUSE_WHEEL_MOVE)>>2] = 0.0;
+            this.u32[(state + INPUT_EVENT_COUNT)>>2] = 0;
+            this.u32[(state + INPUT_KEY_EVENT_HEAD)>>2] = 0;
+            this.u32[(state + INPUT_CHAR_EVENT_HEAD)>>2] = 0;
+        }
+        if (this.ring !== undefined) this.#publishFrame();
+    }
+
+    // The software renderer draws into a framebuffer of a fixed capacity, so the windows that are
+    // too big for it only get the rows that fit
+    #resizeFramebuffer(width, height) {
+        const framebuffer = this.framebuffer;
+        const capacity = this.u32[(framebuffer + FRAMEBUFFER_CAPACITY)>>2];
+        if (width*height > capacity) {
+            console.warn(`The window of ${width}x${height} does not fit into the framebuffer of ${capacity} pixels. Rebuild the game with a bigger RAYLIB_JS_FRAMEBUFFER_CAPACITY.`);
+            width = Math.min(width, capacity);
+            height = Math.floor(capacity/width);
+        }
+        this.i32[(framebuffer + FRAMEBUFFER_WIDTH)>>2] = width;
+        this.i32[(framebuffer + FRAMEBUFFER_HEIGHT)>>2] = height;
+        this.framebufferImage = undefined;
+    }
+
+    // Puts the frame the software renderer has drawn on the canvas. The ImageData is a view of the
+    // framebuffer, so the pixels are only copied by putImageData().
+    #presentFramebuffer() {
+        this.#syncViews();
+        const framebuffer = this.framebuffer;
+        const data = this.framebufferImage?.data;
+        if (data === undefined || data.buffer !== this.buffer) {
+            const width = this.i32[(framebuffer + FRAMEBUFFER_WIDTH)>>2];
+            const height = this.i32[(framebuffer + FRAMEBUFFER_HEIGHT)>>2];
+            if (width === 0 || height === 0) return;
+            const pixels = new Uint8ClampedArray(this.buffer, framebuffer + FRAMEBUFFER_PIXELS, width*height*4);
+            this.framebufferImage = new ImageData(pixels, width, height);
+        }
+        this.ctx.putImageData(this.framebufferImage, 0, 0);
+    }
+
+    // Gives the software renderer a copy of the pixels of a texture loaded from a file, once it's
+    // decoded
+    #bindSoftwareTexture(id, texture) {
+        const copy = () => {
+            const bitmap = texture.bitmap;
+            if (bitmap === undefined || this.textures.get(id) !== texture) return;
+            const ptr = this.exports.raylib_js_software_texture_pixels(id, bitmap.width, bitmap.height);
+            if (ptr === 0) {
+                console.warn(`${texture.path} does not fit into the textures of the software renderer. Rebuild the game with a bigger RAYLIB_JS_SOFTWARE_TEXTURE_ARENA.`);
+                return;
+            }
+            const canvas = new OffscreenCanvas(bitmap.width, bitmap.height);
+            const ctx = canvas.getContext("2d");
+            ctx.drawImage(bitmap, 0, 0);
+            this.#syncViews();
+            this.u8.set(ctx.getImageData(0, 0, bitmap.width, bitmap.height).data, ptr);
+        };
+        if (texture.bitmap !== undefined) {
+            copy();
+        } else {
+            this.decoded.get(texture.path)?.ready.then(copy, () => {});
+        }
+    }
+
+    DrawCircleV(center_ptr, radius, color_ptr) {
+        this.#syncViews();
+        this.#flushBatch();
+        this.#syncTransform();
+        const x = this.f32[center_ptr>>2];
+        const y = this.f32[(center_ptr>>2) + 1];
+        this.#drawCircle(x, y, radius, this.#colorFromMemory(color_ptr));
+    }
+
+    #drawCircle(x, y, radius, color) {
+        this.ctx.beginPath();
+        this.ctx.arc(x, y, radius, 0, 2*Math.PI, false);
+        this.#ctxSet("fillStyle", color);
+        this.ctx.fill();
+    }
+
+    ClearBackground(color_ptr) {
+        this.#syncViews();
+        this.#flushBatch();
+        this.#clearBackground(this.#colorFromMemory(color_ptr));
+    }
+
+    #clearBackground(color) {
+        this.#ctxSet("fillStyle", color);
+        this.#untransformed(() => this.ctx.fillRect(0, 0, this.ctx.canvas.width, this.ctx.canvas.height));
+    }
+
+    // RLAPI void DrawText(const char *text, int posX, int posY, int fontSize, Color color);       // Draw text (using default font)
+    DrawText(text_ptr, posX, posY, fontSize, color_ptr) {
+        this.#syncViews();
+        this.#flushBatch();
+        this.#syncTransform();
+        this.#drawText(this.#cstr(text_ptr), posX, posY, fontSize, this.#colorFromMemory(color_ptr));
+    }
+
+    #drawText(text, posX, posY, fontSize, color) {
+        if (this.defaultFont !== undefined) {
+            // Same as DrawText() of raylib
+            if (fontSize < DEFAULT_FONT_BASE_SIZE) fontSize = DEFAULT_FONT_BASE_SIZE;
+            this.#ctxSet("imageSmoothingEnabled", false);
+            this.defaultFont.draw(this.ctx, text, posX, posY, fontSize, Math.floor(fontSize/DEFAULT_FONT_BASE_SIZE), color);
+            return;
+        }
+        fontSize *= this.#FONT_SCALE_MAGIC;
+        // TODO: since the default font is part of Raylib the css that defines it should be located in raylib.js and not in index.html
+        const font = `${fontSize}px grixel`;
+        if (this.glyphAtlases !== undefined && this.#glyphAtlas("grixel", fontSize).draw(this.ctx, text, posX, posY + fontSize, fontSize, fontSize, color)) {
+            return;
+        }
+        this.#ctxSet("fillStyle", color);
+        this.#ctxSet("font", font);
+
+        const lines = text.split('\n');
+        for (var i = 0; i < lines.length; i++) {
+            this.ctx.fillText(lines[i], posX, posY + fontSize + (i * fontSize));
+        }
+    }
+
+    // RLAPI void DrawRectangle(int posX, int posY, int width, int height, Color color);                        // Draw a color-filled rectangle
+    DrawRectangle(posX, posY, width, height, color_ptr) {
+        this.#syncViews();
+        this.#flushBatch();
+        this.#syncTransform();
+        this.#drawRectangle(posX, posY, width, height, this.#colorFromMemory(color_ptr));
+    }
+
+    DrawRectangleV(position_ptr, size_ptr, color_ptr) {
+        this.#syncViews();
+        this.#flushBatch();
+        this.#syncTransform();
+        const f32 = this.f32;
+        this.#drawRectangle(f32[position_ptr>>2], f32[(position_ptr>>2) + 1], f32[size_ptr>>2], f32[(size_ptr>>2) + 1], this.#colorFromMemory(color_ptr));
+    }
+
+    #drawRectangle(x, y, w, h, color) {
+        this.#ctxSet("fillStyle", color);
+        this.ctx.fillRect(x, y, w, h);
+    }
+
+    IsKeyPressed(key) {
+        return !key_bit(this.prevPressedKeyState, key) && key_bit(this.currentPressedKeyState, key);
+    }
+    IsKeyDown(key) {
+        return key_bit(this.currentPressedKeyState, key);
+    }
+    GetMouseWheelMove() {
+      return this.currentMouseWheelMoveState;
+    }
+    IsGestureDetected() {
+        return false;
+    }
+
+    TextFormat(... args){ 
+        // TODO: Implement printf style formatting for TextFormat
+        return args[0];
+    }
+
+    TraceLog(logLevel, text_ptr, ... args) {
+        // TODO: Implement printf style formatting for TraceLog
+        if (this.scouting !== undefined) return;
+        this.#syncViews();
+        const text = cstr_by_ptr(this.u8, text_ptr);
+        switch(logLevel) {
+        case LOG_ALL:     console.log(`ALL: ${text} ${args}`);     break;
+        case LOG_TRACE:   console.log(`TRACE: ${text} ${args}`);   break;
+        case LOG_DEBUG:   console.log(`DEBUG: ${text} ${args}`);   break;
+        case LOG_INFO:    console.log(`INFO: ${text} ${args}`);    break;
+        case LOG_WARNING: console.log(`WARNING: ${text} ${args}`); break;
+        case LOG_ERROR:   console.log(`ERROR: ${text} ${args}`);   break;
+        case LOG_FATAL:   throw new Error(`FATAL: ${text}`);
+        case LOG_NONE:    console.log(`NONE: ${text} ${args}`);    break;
+        }
+    }
+
+    GetMousePosition(result_ptr) {
+        this.#syncViews();
+        this.f32[result_ptr>>2]       = this.currentMousePosition.x;
+        this.f32[(result_ptr>>2) + 1] = this.currentMousePosition.y;
+    }
+
+    CheckCollisionPointRec(point_ptr, rec_ptr) {
+        this.#syncViews();
+        const f32 = this.f32;
+        const x  = f32[point_ptr>>2];
+        const y  = f32[(point_ptr>>2) + 1];
+        const rx = f32[rec_ptr>>2];
+        const ry = f32[(rec_ptr>>2) + 1];
+        const rw = f32[(rec_ptr>>2) + 2];
+        const rh = f32[(rec_ptr>>2) + 3];
+        return ((x >= rx) && x <= (rx + rw) && (y >= ry) && y <= (ry + rh));
+    }
+
+    Fade(result_ptr, color_ptr, alpha) {
+        this.#syncViews();
+        const u8 = this.u8;
+        const newA = Math.max(0, Math.min(255, 255.0*alpha));
+        // NOTE: result_ptr and color_ptr may alias, so the alpha goes last
+        u8[result_ptr + 0] = u8[color_ptr + 0];
+        u8[result_ptr + 1] = u8[color_ptr + 1];
+        u8[result_ptr + 2] = u8[color_ptr + 2];
+        u8[result_ptr + 3] = newA;
+    }
+
+    DrawRectangleRec(rec_ptr, color_ptr) {
+        this.#syncViews();
+        this.#flushBatch();
+        this.#syncTransform();
+        const f32 = this.f32;
+        this.#drawRectangle(f32[rec_ptr>>2], f32[(rec_ptr>>2) + 1], f32[(rec_ptr>>2) + 2], f32[(rec_ptr>>2) + 3], this.#colorFromMemory(color_ptr));
+    }
+
+    DrawRectangleLinesEx(rec_ptr, lineThick, color_ptr) {
+        this.#syncViews();
+        this.#flushBatch();
+        this.#syncTransform();
+        const f32 = this.f32;
+        const x = f32[rec_ptr>>2];
+        const y = f32[(rec_ptr>>2) + 1];
+        const w = f32[(rec_ptr>>2) + 2];
+        const h = f32[(rec_ptr>>2) + 3];
+        this.#drawRectangleLines(x, y, w, h, lineThick, this.#colorFromMemory(color_ptr));
+    }
+
+    #drawRectangleLines(x, y, w, h, lineThick, color) {
+        this.#ctxSet("strokeStyle", color);
+        this.#ctxSet("lineWidth", lineThick);
+        this.ctx.strokeRect(x + lineThick/2, y + lineThick/2, w - lineThick, h - lineThick);
+    }
+
+    MeasureText(text_ptr, fontSize) {
+        this.#syncViews();
+        const text = this.#cstr(text_ptr);
+        fontSize *= this.#FONT_SCALE_MAGIC;
+        return this.#measureText(`${fontSize}px grixel`, text);
+    }
+
+    TextSubtext(text_ptr, position, length) {
+        this.#syncViews();
+        const text = cstr_by_ptr(this.u8, text_ptr);
+        const subtext = text.substring(position, length);
+
+        var bytes = new Uint8Array(this.buffer, 0, subtext.length+1);
+        for(var i = 0; i < subtext.length; i++) {
+            bytes[i] = subtext.charCodeAt(i);
+        }
+        bytes[subtext.length] = 0;
+
+        return bytes;
+    }
+
+    // RLAPI Texture2D LoadTexture(const char *fileName);
+    LoadTexture(result_ptr, filename_ptr) {
+        this.#syncViews();
+        const filename = cstr_by_ptr(this.u8, filename_ptr);
+
+        var result = new Uint32Array(this.buffer, result_ptr, 5)
+        // NOTE: the real size is only known once the image is decoded, see the preload and jspi
+        // options of start()
+        result[0] = 0; // id
+        result[1] = TEXTURE_PENDING_SIZE; // width
+        result[2] = TEXTURE_PENDING_SIZE; // height
+        if (this.scouting !== undefined) {
+            this.scouting.push({kind: "texture", path: filename});
+        } else if (this.ring !== undefined) {
+            // The page draws, so it gets a copy of the preloaded image, or decodes it itself
+            const bitmap = this.decoded.get(filename)?.bitmap;
+            result[0] = this.textures.add({path: filename, bitmap: undefined});
+            postMessage([WORKER_LOAD_TEXTURE, result[0], asset_url(filename), bitmap]);
+            if (bitmap !== undefined) {
+                result[1] = bitmap.width;
+                result[2] = bitmap.height;
+            }
+        } else {
+            const texture = this.#loadTexture(filename);
+            result[0] = this.textures.add(texture);
+            if (this.framebuffer !== undefined) this.#bindSoftwareTexture(result[0], texture);
+            if (texture.bitmap !== undefined) {
+                result[1] = texture.bitmap.width;
+                result[2] = texture.bitmap.height;
+            }
+        }
+        this.stats.textures = this.textures.count;
+        result[3] = 1; // mipmaps
+        result[4] = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8; // format
+
+        return result;
+    }
+
+    // RLAPI void DrawTexture(Texture2D texture, int posX, int posY, Color tint);
+    DrawTexture(texture_ptr, posX, posY, color_ptr) {
+        this.#syncViews();
+        this.#flushBatch();
+        this.#syncTransform();
+        this.#drawTexture(this.u32[texture_ptr>>2], posX, posY, this.#packedColorFromMemory(color_ptr));
+    }
+
+    #drawTexture(id, posX, posY, tint) {
+        const image = this.#tintedTexture(id, tint);
+        if (image === undefined) return;
+        if (tint < 0xFF000000) this.ctx.globalAlpha = (tint>>>24)/255;
+        this.ctx.drawImage(image, posX, posY);
+        if (tint < 0xFF000000) this.ctx.globalAlpha = 1;
+    }
+
+    // RLAPI void DrawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint);
+    DrawTexturePro(texture_ptr, source_ptr, dest_ptr, origin_ptr, rotation, color_ptr) {
+        this.#syncViews();
+        this.#flushBatch();
+        this.#syncTransform();
+        const f32 = this.f32;
+        const source = source_ptr>>2;
+        const dest = dest_ptr>>2;
+        const origin = origin_ptr>>2;
+        this.#drawTexturePro(this.u32[texture_ptr>>2],
+                             f32[source], f32[source + 1], f32[source + 2], f32[source + 3],
+                             f32[dest], f32[dest + 1], f32[dest + 2], f32[dest + 3],
+                             f32[origin], f32[origin + 1], rotation, this.#packedColorFromMemory(color_ptr));
+    }
+
+    // The negative width or height of the source flips the texture as in raylib
+    #drawTexturePro(id, sx, sy, sw, sh, dx, dy, dw, dh, ox, oy, rotation, tint) {
+        const image = this.#tintedTexture(id, tint);
+        if (image === undefined) return;
+        const ctx = this.ctx;
+        if (rotation === 0 && sw >= 0 && sh >= 0) {
+            if (tint < 0xFF000000) ctx.globalAlpha = (tint>>>24)/255;
+            ctx.drawImage(image, sx, sy, sw, sh, dx - ox, dy - oy, dw, dh);
+            if (tint < 0xFF000000) ctx.globalAlpha = 1;
+            return;
+        }
+        ctx.save();
+        ctx.translate(dx, dy);
+        ctx.rotate(rotation*Math.PI/180);
+        ctx.translate(sw < 0 ? dw - ox : -ox, sh < 0 ? dh - oy : -oy);
+        ctx.scale(sw < 0 ? -1 : 1, sh < 0 ? -1 : 1);
+        ctx.globalAlpha = (tint>>>24)/255;
+        ctx.drawImage(image, sx, sy, Math.abs(sw), Math.abs(sh), 0, 0, dw, dh);
+        ctx.restore();
+    }
+
+    // The image of the texture multiplied by the RGB of the tint. The drawing applies the alpha.
+    #tintedTexture(id, tint) {
+        const texture = this.textures.get(id);
+        if (texture === undefined) return undefined;
+        if (texture.dirty) this.#uploadPixels(texture);
+        if (texture.bitmap === undefined || (tint&0xFFFFFF) === 0xFFFFFF) return texture.bitmap;
+        return this.tintCache.get(id, texture.bitmap, texture.version ?? 0, tint&0xFFFFFF);
+    }
+
+    // RLAPI Texture2D LoadTextureFromImage(Image image);
+    // The texture is a canvas the pixels of the image are put into. It keeps the pixels where they
+    // are in the linear memory, so UpdateTexture() with the same pixels copies them only once,
+    // the next time the texture is drawn.
+    LoadTextureFromImage(result_ptr, image_ptr) {
+        this.#syncViews();
+        const [pixels, width, height, /*mipmaps*/, format] = this.u32.subarray(image_ptr>>2, (image_ptr>>2) + 5);
+        const result = new Uint32Array(this.buffer, result_ptr, 5);
+        result.fill(0);
+        if (this.scouting !== undefined) return;
+        if (format !== PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) {
+            console.warn(`LoadTextureFromImage: the pixel format ${format} is not supported, only PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 is`);
+            return;
+        }
+        if (IS_WORKER && this.ring !== undefined) {
+            // The page of the blocking mode has no access to the memory of the game, so it gets a
+            // copy of the pixels. Like the ones of UpdateTexture() they reach it between two
+            // frames, which may not be the ones the game has drawn them in.
+            result[0] = this.textures.add({path: undefined, bitmap: undefined, pixels, width, height});
+            const copy = new Uint8ClampedArray(this.u8.subarray(pixels, pixels + width*height*4));
+            postMessage([WORKER_LOAD_PIXELS, result[0], width, height, copy], [copy.buffer]);
+            result[1] = width;
+            result[2] = height;
+            result[3] = 1; // mipmaps
+            result[4] = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+            this.stats.textures = this.textures.count;
+            return;
+        }
+        if (this.framebuffer !== undefined) {
+            this.#loadSoftwareTextureFromImage(result, pixels, width, height);
+            return;
+        }
+        const bitmap = new OffscreenCanvas(width, height);
+        const texture = {
+            path: undefined,
+            bitmap,
+            ctx: bitmap.getContext("2d"),
+            pixels,
+            width,
+            height,
+            imageData: undefined,
+            dirty: true,
+            version: 0,
+        };
+        result[0] = this.textures.add(texture);
+        result[1] = width;
+        result[2] = height;
+        result[3] = 1; // mipmaps
+        result[4] = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+        this.stats.textures = this.textures.count;
+        this.stats.textureBytes += bitmap_bytes(bitmap);
+    }
+
+    // The software renderer draws the texture from a copy of the pixels of the image in the linear
+    // memory, which is made with copyWithin() without leaving it
+    #loadSoftwareTextureFromImage(result, pixels, width, height) {
+        const texture = {path: undefined, bitmap: undefined, pixels: 0, width, height};
+        const id = this.textures.add(texture);
+        texture.pixels = this.exports.raylib_js_software_texture_pixels(id, width, height);
+        if (texture.pixels === 0) {
+            console.warn(`LoadTextureFromImage: the image of ${width}x${height} does not fit into the textures of the software renderer. Rebuild the game with a bigger RAYLIB_JS_SOFTWARE_TEXTURE_ARENA.`);
+            this.textures.remove(id);
+            return;
+        }
+        this.#syncViews();
+        this.u8.copyWithin(texture.pixels, pixels, pixels + width*height*4);
+        result[0] = id;
+        result[1] = width;
+        result[2] = height;
+        result[3] = 1; // mipmaps
+        result[4] = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+        this.stats.textures = this.textures.count;
+    }
+
+    // RLAPI void UpdateTexture(Texture2D texture, const void *pixels);
+    UpdateTexture(texture_ptr, pixels_ptr) {
+        this.#syncViews();
+        const id = this.u32[texture_ptr>>2];
+        const texture = this.textures.get(id);
+        if (texture?.pixels === undefined) return;
+        if (this.framebuffer !== undefined) {
+            this.u8.copyWithin(texture.pixels, pixels_ptr, pixels_ptr + texture.width*texture.height*4);
+            return;
+        }
+        if (IS_WORKER && this.ring !== undefined) {
+            const copy = new Uint8ClampedArray(this.u8.subarray(pixels_ptr, pixels_ptr + texture.width*texture.height*4));
+            postMessage([WORKER_UPDATE_PIXELS, id, 0, 0, texture.width, texture.height, copy], [copy.buffer]);
+            return;
+        }
+        texture.pixels = pixels_ptr;
+        texture.dirty = true;
+    }
+
+    // RLAPI void UpdateTextureRec(Texture2D texture, Rectangle rec, const void *pixels);
+    // Unlike UpdateTexture() the pixels are only the ones of the rectangle, so they are put into the
+    // texture right away.
+    UpdateTextureRec(texture_ptr, rec_ptr, pixels_ptr) {
+        this.#syncViews();
+        const id = this.u32[texture_ptr>>2];
+        const texture = this.textures.get(id);
+        if (texture?.pixels === undefined) return;
+        const [x, y, width, height] = this.f32.subarray(rec_ptr>>2, (rec_ptr>>2) + 4);
+        if (this.framebuffer !== undefined) {
+            for (let row = 0; row < height; ++row) {
+                const from = pixels_ptr + row*width*4;
+                this.u8.copyWithin(texture.pixels + ((y + row)*texture.width + x)*4, from, from + width*4);
+            }
+            return;
+        }
+        if (IS_WORKER && this.ring !== undefined) {
+            const copy = new Uint8ClampedArray(this.u8.subarray(pixels_ptr, pixels_ptr + width*height*4));
+            postMessage([WORKER_UPDATE_PIXELS, id, x, y, width, height, copy], [copy.buffer]);
+            return;
+        }
+        // The commands recorded so far may still draw the previous pixels
+        this.#flushBatch();
+        if (this.commandBuffer !== undefined) this.raylib_js_flush_commands();
+        if (texture.dirty) this.#uploadPixels(texture);
+        const rect = new ImageData(new Uint8ClampedArray(this.buffer, pixels_ptr, width*height*4), width, height);
+        texture.ctx.putImageData(rect, x, y);
+        texture.version += 1;
+    }
+
+    // Puts the pixels the game has updated into the canvas of the texture
+    #uploadPixels(texture) {
+        const data = texture.imageData?.data;
+        if (data === undefined || data.buffer !== this.buffer || data.byteOffset !== texture.pixels) {
+            // A view of the pixels, they are only copied by putImageData()
+            const pixels = new Uint8ClampedArray(this.buffer, texture.pixels, texture.width*texture.height*4);
+            texture.imageData = new ImageData(pixels, texture.width, texture.height);
+        }
+        texture.ctx.putImageData(texture.imageData, 0, 0);
+        texture.dirty = false;
+        texture.version += 1;
+    }
+
+    // RLAPI void UnloadTexture(Texture2D texture);
+    UnloadTexture(texture_ptr) {
+        this.#syncViews();
+        // The commands recorded so far may still draw it
+        this.#flushBatch();
+        if (this.commandBuffer !== undefined && this.ring === undefined) this.raylib_js_flush_commands();
+        this.#unloadTexture(this.u32[texture_ptr>>2]);
+    }
+
+    // TODO: codepoints are not implemented
+    LoadFontEx(result_ptr, fileName_ptr, fontSize/*, codepoints, codepointCount*/) {
+        this.#syncViews();
+        const fileName = cstr_by_ptr(this.u8, fileName_ptr);
+        const result = new Int32Array(this.buffer, result_ptr, 10);
+        result.fill(0);
+        result[0] = fontSize; // baseSize
+        result[1] = 95; // glyphCount, the default character set of raylib
+        if (this.scouting !== undefined) {
+            this.scouting.push({kind: "font", path: fileName});
+            return;
+        }
+        // Only the id of the texture is used, it tells which font it is
+        result[3] = this.fonts.add(this.#loadFont(fileName));
+        result[6] = 1; // texture.mipmaps
+        result[7] = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8; // texture.format
+        this.stats.fonts = this.fonts.count;
+        if (this.ring !== undefined) postMessage([WORKER_LOAD_FONT, result[3], asset_url(fileName)]);
+    }
+
+    // RLAPI void UnloadFont(Font font);
+    UnloadFont(font_ptr) {
+        this.#syncViews();
+        if (this.commandBuffer !== undefined && this.ring === undefined) this.raylib_js_flush_commands();
+        this.#unloadFont(this.u32[(font_ptr>>2) + 3]);
+    }
+
+    GenTextureMipmaps() {}
+    SetTextureFilter() {}
+
+    MeasureTextEx(result_ptr, font_ptr, text_ptr, fontSize, spacing) {
+        this.#syncViews();
+        const text = this.#cstr(text_ptr);
+        const family = this.#fontFamily(this.u32[(font_ptr>>2) + 3]);
+        this.f32[result_ptr>>2]       = this.#measureText(`${fontSize}px ${family}`, text);
+        this.f32[(result_ptr>>2) + 1] = fontSize;
+    }
+
+    DrawTextEx(font_ptr, text_ptr, position_ptr, fontSize, spacing, tint_ptr) {
+        this.#syncViews();
+        this.#flushBatch();
+        this.#syncTransform();
+        const text = this.#cstr(text_ptr);
+        const posX = this.f32[position_ptr>>2];
+        const posY = this.f32[(position_ptr>>2) + 1];
+        this.#drawTextEx(this.u32[(font_ptr>>2) + 3], text, posX, posY, fontSize, spacing, this.#colorFromMemory(tint_ptr));
+    }
+
+    #drawTextEx(fontId, text, posX, posY, fontSize, spacing, tint) {
+        const font = `${fontSize}px ${this.#fontFamily(fontId)}`;
+        if (this.glyphAtlases !== undefined && this.#glyphAtlas(this.#fontFamily(fontId), fontSize).draw(this.ctx, text, posX, posY + fontSize, fontSize, fontSize, tint)) {
+            return;
+        }
+        this.#ctxSet("fillStyle", tint);
+        this.#ctxSet("font", font);
+        this.ctx.fillText(text, posX, posY + fontSize);
+    }
+
+    // See src/raylib_js.h. RAYLIB_JS_COMMAND_BUFFER builds keep whether the layers are dirty
+    // themselves and only record the commands that call #beginLayer() and the like.
+    BeginLayer(id) {
+        // NOTE: the software renderer draws the layer right away, as if it was recorded every frame
+        if (this.framebuffer !== undefined) return true;
+        this.#syncViews();
+        this.#flushBatch();
+        const layer = this.layers.get(id);
+        if (layer !== undefined && !layer.dirty) return false;
+        this.#beginLayer(id);
+        return true;
+    }
+
+    EndLayer() {
+        this.#syncViews();
+        this.#flushBatch();
+        this.#endLayer();
+    }
+
+    DrawLayer(id, posX, posY) {
+        this.#syncViews();
+        this.#flushBatch();
+        this.#syncTransform();
+        this.#drawLayer(id, posX, posY);
+    }
+
+    MarkLayerDirty(id) {
+        const layer = this.layers.get(id);
+        if (layer !== undefined) layer.dirty = true;
+    }
+
+    UnloadLayer(id) {
+        this.#syncViews();
+        this.#flushBatch();
+        this.#unloadLayer(id);
+    }
+
+    // Everything drawn from now on goes into the layer, until #endLayer(). The layer has its own
+    // context, so it has its own cached state and transform too.
+    #beginLayer(id) {
+        // Layers don't nest
+        if (this.layerTarget !== undefined) this.#endLayer();
+        const {width, height} = this.ctx.canvas;
+        let layer = this.layers.get(id);
+        if (layer === undefined) {
+            layer = {ctx: new OffscreenCanvas(width, height).getContext("2d"), dirty: true, stats: {redraws: 0, draws: 0}};
+            this.layers.set(id, layer);
+            this.stats.layers[id] = layer.stats;
+        }
+        const canvas = layer.ctx.canvas;
+        if (canvas.width !== width || canvas.height !== height) {
+            // Resizing the canvas clears it and resets the state of its context
+            canvas.width = width;
+            canvas.height = height;
+        } else {
+            layer.ctx.setTransform(1, 0, 0, 1, 0, 0);
+            layer.ctx.clearRect(0, 0, width, height);
+        }
+        layer.dirty = false;
+        layer.stats.redraws += 1;
+        this.layerTarget = {ctx: this.ctx, ctxState: this.ctxState, transform: this.transform, transformVersion: this.transformVersion};
+        this.ctx = layer.ctx;
+        this.ctxState = {};
+        this.transform = [1, 0, 0, 1, 0, 0];
+        this.transformVersion = undefined;
+    }
+
+    #endLayer() {
+        if (this.layerTarget === undefined) return;
+        ({ctx: this.ctx, ctxState: this.ctxState, transform: this.transform, transformVersion: this.transformVersion} = this.layerTarget);
+        this.layerTarget = undefined;
+    }
+
+    #drawLayer(id, posX, posY) {
+        if (this.framebuffer !== undefined) return;
+        const layer = this.layers.get(id);
+        if (layer === undefined || layer.ctx === this.ctx) return;
+        this.ctx.drawImage(layer.ctx.canvas, posX, posY);
+        layer.stats.draws += 1;
+    }
+
+    #unloadLayer(id) {
+        const layer = this.layers.get(id);
+        if (layer === undefined) return;
+        if (layer.ctx === this.ctx) this.#endLayer();
+        release_canvas(layer.ctx.canvas);
+        this.layers.delete(id);
+        delete this.stats.layers[id];
+    }
+
+    GetRandomValue(min, max) {
+        return min + Math.floor(Math.random()*(max - min + 1));
+    }
+
+    ColorFromHSV(result_ptr, hue, saturation, value) {
+        this.#syncViews();
+        const result = this.u8;
+
+        // Red channel
+        let k = (5.0 + hue/60.0)%6;
+        let t = 4.0 - k;
+        k = (t < k)? t : k;
+        k = (k < 1)? k : 1;
+        k = (k > 0)? k : 0;
+        result[result_ptr + 0] = Math.floor((value - value*saturation*k)*255.0);
+
+        // Green channel
+        k = (3.0 + hue/60.0)%6;
+        t = 4.0 - k;
+        k = (t < k)? t : k;
+        k = (k < 1)? k : 1;
+        k = (k > 0)? k : 0;
+        result[result_ptr + 1] = Math.floor((value - value*saturation*k)*255.0);
+
+        // Blue channel
+        k = (1.0 + hue/60.0)%6;
+        t = 4.0 - k;
+        k = (t < k)? t : k;
+        k = (k < 1)? k : 1;
+        k = (k > 0)? k : 0;
+        result[result_ptr + 2] = Math.floor((value - value*saturation*k)*255.0);
+
+        result[result_ptr + 3] = 255;
     }
 
-    constructor() {
-        this.#reset();
+    // The functions of include/math.h. The modules have no libm, so the ones raymath.h calls and
+    // clang does not turn into instructions are imported from here.
+    floorf(x) { return Math.fround(Math.floor(x)); }
+    fabsf(x) { return Math.fround(Math.abs(x)); }
+    fabs(x) { return Math.abs(x); }
+    fmaxf(x, y) { return Math.fround(Math.max(x, y)); }
+    fminf(x, y) { return Math.fround(Math.min(x, y)); }
+    sqrtf(x) { return Math.fround(Math.sqrt(x)); }
+    atan2f(y, x) { return Math.fround(Math.atan2(y, x)); }
+    cosf(x) { return Math.fround(Math.cos(x)); }
+    sinf(x) { return Math.fround(Math.sin(x)); }
+    acosf(x) { return Math.fround(Math.acos(x)); }
+    asinf(x) { return Math.fround(Math.asin(x)); }
+    tan(x) { return Math.tan(x); }
+
+    // Executes the commands recorded by a RAYLIB_JS_COMMAND_BUFFER build and empties the buffer.
+    // See src/raylib_js.h for the layout of the commands.
+    raylib_js_flush_commands() {
+        this.#syncViews();
+        const count = this.commandBuffer>>2;
+        if (this.ring !== undefined) {
+            // The page draws them, see #presentFrame()
+            this.ring.write(this.u32, count + 2, this.u32[count]);
+        } else {
+            this.#executeCommands(count + 2, count + 2 + this.u32[count]);
+        }
+        this.u32[count] = 0;
     }
 
-    stop() {
-        this.quit = true;
+    // The direct draws are in the coordinates of the current matrix of the game, which is only read
+    // again after it has changed. See src/raylib_js_camera.c.
+    #syncTransform() {
+        const state = this.transformState;
+        if (state === undefined) return;
+        const version = this.u32[(state + TRANSFORM_VERSION)>>2];
+        if (version === this.transformVersion) return;
+        this.transformVersion = version;
+        const matrix = (state + TRANSFORM_MATRIX)>>2;
+        const f32 = this.f32;
+        this.#applyTransform(f32[matrix], f32[matrix + 1], f32[matrix + 2], f32[matrix + 3], f32[matrix + 4], f32[matrix + 5]);
     }
 
-    async startExports({ exports, canvasId }) {
-        console.log(exports);
+    #applyTransform(a, b, c, d, e, f) {
+        const t = this.transform;
+        if (t[0] === a && t[1] === b && t[2] === c && t[3] === d && t[4] === e && t[5] === f) return;
+        t[0] = a; t[1] = b; t[2] = c; t[3] = d; t[4] = e; t[5] = f;
+        this.ctx.setTransform(a, b, c, d, e, f);
+        this.stats.transformChanges += 1;
+    }
 
-        if (this.exports !== undefined) {
-            console.error("The game is already running. Please stop() it first.");
+    // For what is in the coordinates of the screen whatever the current matrix is
+    #untransformed(draw) {
+        const t = this.transform;
+        if (t[0] === 1 && t[1] === 0 && t[2] === 0 && t[3] === 1 && t[4] === 0 && t[5] === 0) {
+            draw();
             return;
         }
+        this.ctx.setTransform(1, 0, 0, 1, 0, 0);
+        draw();
+        this.ctx.setTransform(t[0], t[1], t[2], t[3], t[4], t[5]);
+    }
 
-        const canvas = document.getElementById(canvasId);
-        this.ctx = canvas.getContext("2d");
-        if (this.ctx === null) {
-            throw new Error("Could not create 2d canvas context");
+    // Draws the primitives the game has batched through rlgl, before anything that is not batched
+    // is drawn over them. With a command buffer the batch is recorded after the commands instead,
+    // and drawn when they are executed.
+    #flushBatch() {
+        if (this.renderBatch === undefined || this.u32[(this.renderBatch + BATCH_VERTEX_COUNT)>>2] === 0) return;
+        if (this.commandBuffer !== undefined) {
+            this.exports.raylib_js_record_batch();
+        } else {
+            this.raylib_js_draw_batch();
         }
+    }
 
-        this.exports = exports;
-
-        const keyDown = (e) => {
-            this.currentPressedKeyState.add(glfwKeyMapping[e.code]);
-        };
-        const keyUp = (e) => {
-            this.currentPressedKeyState.delete(glfwKeyMapping[e.code]);
-        };
-        const wheelMove = (e) => {
-          this.currentMouseWheelMoveState = Math.sign(-e.deltaY);
-        };
-        const mouseMove = (e) => {
-            this.currentMousePosition = {x: e.clientX, y: e.clientY};
-        };
-        window.addEventListener("keydown", keyDown);
-        window.addEventListener("keyup", keyUp);
-        window.addEventListener("wheel", wheelMove);
-        window.addEventListener("mousemove", mouseMove);
+    // Draws the batch of a RAYLIB_JS_RLGL build and empties it. See src/raylib_js.h for the layout.
+    raylib_js_draw_batch() {
+        this.#syncViews();
+        const u32 = this.u32;
+        const batch = this.renderBatch;
+        this.#drawBatch((batch + BATCH_DRAWS)>>2, u32[(batch + BATCH_DRAW_COUNT)>>2], (batch + BATCH_VERTICES)>>2);
+        u32[(batch + BATCH_VERTEX_COUNT)>>2] = 0;
+        u32[(batch + BATCH_DRAW_COUNT)>>2] = 0;
+    }
 
-        this.exports.main();
-        const next = (timestamp) => {
-            if (this.quit) {
-                this.ctx.clearRect(0, 0, this.ctx.canvas.width, this.ctx.canvas.height);
-                window.removeEventListener("keydown", keyDown);
-                this.#reset()
-                return;
+    // Draws the draws at the word index `draws` of the current views, whose vertices start at the
+    // word index `vertices`. The vertices are already transformed, see src/raylib_js_rlgl.c.
+    #drawBatch(draws, drawCount, vertices) {
+        const u32 = this.u32;
+        const words = BATCH_VERTEX_SIZE>>2;
+        let vertexCount = 0;
+        this.#untransformed(() => {
+            for (let i = 0; i < drawCount; ++i) {
+                const draw = draws + i*(BATCH_DRAW_SIZE>>2);
+                const [mode, texture, start, count] = u32.subarray(draw, draw + 4);
+                const first = vertices + start*words;
+                switch (mode) {
+                case RL_LINES:     this.#drawBatchLines(first, count); break;
+                case RL_TRIANGLES: this.#drawBatchPolygons(first, count, 3, texture); break;
+                case RL_QUADS:     this.#drawBatchPolygons(first, count, 4, texture); break;
+                }
+                vertexCount += count;
             }
-            this.dt = (timestamp - this.previous)/1000.0;
-            this.previous = timestamp;
-            this.entryFunction();
-            window.requestAnimationFrame(next);
-        };
-        window.requestAnimationFrame((timestamp) => {
-            this.previous = timestamp;
-            window.requestAnimationFrame(next);
         });
+        this.stats.batchFlushes += 1;
+        this.stats.batchDraws += drawCount;
+        this.stats.batchVertices += vertexCount;
     }
 
-    async start({ wasmPath, canvasId }) {
-        let wasm = await WebAssembly.instantiateStreaming(fetch(wasmPath), {
-            env: make_environment(this)
-        });
-
-        this.startExports( {
-            exports: wasm.instance.exports,
-            canvasId,
-        })
+    // The lines of the same color that follow each other are stroked as one path. A line whose ends
+    // have different colors is stroked on its own with a gradient between them.
+    #drawBatchLines(first, count) {
+        const ctx = this.ctx;
+        const u32 = this.u32;
+        const f32 = this.f32;
+        const words = BATCH_VERTEX_SIZE>>2;
+        let color = undefined;
+        for (let i = 0, v = first; i < count; i += 2, v += 2*words) {
+            const w = v + words;
+            if (u32[v + 4] !== u32[w + 4]) {
+                if (color !== undefined) ctx.stroke();
+                color = undefined;
+                const gradient = ctx.createLinearGradient(f32[v], f32[v + 1], f32[w], f32[w + 1]);
+                gradient.addColorStop(0, this.#color(u32[v + 4]));
+                gradient.addColorStop(1, this.#color(u32[w + 4]));
+                this.#ctxSet("strokeStyle", gradient);
+                this.#ctxSet("lineWidth", 1);
+                ctx.beginPath();
+                ctx.moveTo(f32[v], f32[v + 1]);
+                ctx.lineTo(f32[w], f32[w + 1]);
+                ctx.stroke();
+                continue;
+            }
+            if (u32[v + 4] !== color) {
+                if (color !== undefined) ctx.stroke();
+                color = u32[v + 4];
+                this.#ctxSet("strokeStyle", this.#color(color));
+                this.#ctxSet("lineWidth", 1);
+                ctx.beginPath();
+            }
+            ctx.moveTo(f32[v], f32[v + 1]);
+            ctx.lineTo(f32[w], f32[w + 1]);
+        }
+        if (color !== undefined) ctx.stroke();
     }
 
-    InitWindow(width, height, title_ptr) {
-        this.ctx.canvas.width = width;
-        this.ctx.canvas.height = height;
-        const buffer = this.exports.memory.buffer;
-        document.title = cstr_by_ptr(buffer, title_ptr);
+    // The untextured triangles or quads of the same color that follow each other are filled as one
+    // path, so there are no seams between them. The canvas can't blend the colors of three or four
+    // vertices, so every one of them has the color of its first vertex.
+    #drawBatchPolygons(first, count, sides, texture) {
+        const ctx = this.ctx;
+        const u32 = this.u32;
+        const f32 = this.f32;
+        const words = BATCH_VERTEX_SIZE>>2;
+        if (texture !== 0) {
+            for (let i = 0, v = first; i < count; i += sides, v += sides*words) {
+                if (sides === 4) {
+                    this.#drawBatchTexturedQuad(texture, v, v + words, v + 2*words, v + 3*words);
+                } else {
+                    this.#drawBatchTexturedTriangle(texture, v, v + words, v + 2*words);
+                }
+            }
+            // The quads leave the transform and the alpha behind, see #drawBatchTexturedQuad()
+            ctx.setTransform(1, 0, 0, 1, 0, 0);
+            ctx.globalAlpha = 1;
+            return;
+        }
+        let color = undefined;
+        for (let i = 0, v = first; i < count; i += sides, v += sides*words) {
+            if (u32[v + 4] !== color) {
+                if (color !== undefined) ctx.fill();
+                color = u32[v + 4];
+                this.#ctxSet("fillStyle", this.#color(color));
+                ctx.beginPath();
+            }
+            if (!this.vertexColorsWarned) {
+                for (let k = 1; k < sides; ++k) {
+                    if (u32[v + k*words + 4] === color) continue;
+                    console.warn("RAYLIB_JS_RLGL: the triangles and the quads are filled with the color of their first vertex, the canvas can't blend the colors of their vertices");
+                    this.vertexColorsWarned = true;
+                    break;
+                }
+            }
+            // All of them wound the same way, so the nonzero rule fills their union
+            let area = 0;
+            for (let k = 0; k < sides; ++k) {
+                const a = v + k*words;
+                const b = v + ((k + 1)%sides)*words;
+                area += f32[a]*f32[b + 1] - f32[b]*f32[a + 1];
+            }
+            const step = area < 0 ? -words : words;
+            let vertex = area < 0 ? v + (sides - 1)*words : v;
+            ctx.moveTo(f32[vertex], f32[vertex + 1]);
+            for (let k = 1; k < sides; ++k) {
+                vertex += step;
+                ctx.lineTo(f32[vertex], f32[vertex + 1]);
+            }
+            ctx.closePath();
+        }
+        if (color !== undefined) ctx.fill();
     }
 
-    WindowShouldClose(){
-        return false;
+    // The affine transform that takes the texture coordinates of the triangle, in the pixels of
+    // the image, to its vertices. Undefined if the texture coordinates are on a line.
+    #textureTransform(image, a, b, c) {
+        const f32 = this.f32;
+        const [x0, y0, u0, v0] = [f32[a], f32[a + 1], f32[a + 2]*image.width, f32[a + 3]*image.height];
+        const [x1, y1, u1, v1] = [f32[b], f32[b + 1], f32[b + 2]*image.width, f32[b + 3]*image.height];
+        const [x2, y2, u2, v2] = [f32[c], f32[c + 1], f32[c + 2]*image.width, f32[c + 3]*image.height];
+        const det = (u1 - u0)*(v2 - v0) - (u2 - u0)*(v1 - v0);
+        if (det === 0) return undefined;
+        const ma = ((x1 - x0)*(v2 - v0) - (x2 - x0)*(v1 - v0))/det;
+        const mb = ((y1 - y0)*(v2 - v0) - (y2 - y0)*(v1 - v0))/det;
+        const mc = ((x2 - x0)*(u1 - u0) - (x1 - x0)*(u2 - u0))/det;
+        const md = ((y2 - y0)*(u1 - u0) - (y1 - y0)*(u2 - u0))/det;
+        return [ma, mb, mc, md, x0 - ma*u0 - mc*v0, y0 - mb*u0 - md*v0];
     }
 
-    SetTargetFPS(fps) {
-        console.log(`The game wants to run at ${fps} FPS, but in Web we gonna just ignore it.`);
-        this.targetFPS = fps;
+    // A quad is usually a rectangle of the texture mapped onto a parallelogram, like the ones of
+    // DrawTexturePro(). That is a single drawImage() of the rectangle under the transform of the
+    // quad, without a clip. The transform and the alpha are left as they are, so the quads that
+    // follow each other don't save and restore the whole state of the context.
+    #drawBatchTexturedQuad(id, a, b, c, d) {
+        const f32 = this.f32;
+        const tint = this.u32[a + 4];
+        const image = this.#tintedTexture(id, tint);
+        if (image === undefined) return;
+        const m = this.#textureTransform(image, a, b, c);
+        if (m === undefined) return;
+        const ud = f32[d + 2]*image.width;
+        const vd = f32[d + 3]*image.height;
+        const parallelogram = Math.abs(m[0]*ud + m[2]*vd + m[4] - f32[d]) < 0.01
+                           && Math.abs(m[1]*ud + m[3]*vd + m[5] - f32[d + 1]) < 0.01;
+        if (!parallelogram) {
+            this.#drawBatchTexturedTriangle(id, a, b, c);
+            this.#drawBatchTexturedTriangle(id, a, c, d);
+            return;
+        }
+        const us = [f32[a + 2], f32[b + 2], f32[c + 2], f32[d + 2]];
+        const vs = [f32[a + 3], f32[b + 3], f32[c + 3], f32[d + 3]];
+        const u0 = Math.min(...us), u1 = Math.max(...us);
+        const v0 = Math.min(...vs), v1 = Math.max(...vs);
+        const rectangle = us.every((u) => u === u0 || u === u1) && vs.every((v) => v === v0 || v === v1);
+        const ctx = this.ctx;
+        if (!rectangle) {
+            // Rotated within the texture, so the quad is cut out of the whole image
+            ctx.save();
+            ctx.setTransform(1, 0, 0, 1, 0, 0);
+            ctx.beginPath();
+            ctx.moveTo(f32[a], f32[a + 1]);
+            ctx.lineTo(f32[b], f32[b + 1]);
+            ctx.lineTo(f32[c], f32[c + 1]);
+            ctx.lineTo(f32[d], f32[d + 1]);
+            ctx.closePath();
+            ctx.clip();
+            ctx.transform(m[0], m[1], m[2], m[3], m[4], m[5]);
+            ctx.globalAlpha = (tint>>>24)/255;
+            ctx.drawImage(image, 0, 0);
+            ctx.restore();
+            return;
+        }
+        const sx = u0*image.width;
+        const sy = v0*image.height;
+        const sw = (u1 - u0)*image.width;
+        const sh = (v1 - v0)*image.height;
+        ctx.setTransform(m[0], m[1], m[2], m[3], m[4], m[5]);
+        ctx.globalAlpha = (tint>>>24)/255;
+        ctx.drawImage(image, sx, sy, sw, sh, sx, sy, sw, sh);
     }
 
-    GetScreenWidth() {
-        return this.ctx.canvas.width;
+    // Maps the texture onto the triangle with the transform of its texture coordinates, clipped to it
+    #drawBatchTexturedTriangle(id, a, b, c) {
+        const f32 = this.f32;
+        const tint = this.u32[a + 4];
+        const image = this.#tintedTexture(id, tint);
+        if (image === undefined) return;
+        const m = this.#textureTransform(image, a, b, c);
+        if (m === undefined) return;
+        const ctx = this.ctx;
+        ctx.save();
+        ctx.setTransform(1, 0, 0, 1, 0, 0);
+        ctx.beginPath();
+        ctx.moveTo(f32[a], f32[a + 1]);
+        ctx.lineTo(f32[b], f32[b + 1]);
+        ctx.lineTo(f32[c], f32[c + 1]);
+        ctx.closePath();
+        ctx.clip();
+        ctx.transform(m[0], m[1], m[2], m[3], m[4], m[5]);
+        ctx.globalAlpha = (tint>>>24)/255;
+        ctx.drawImage(image, 0, 0);
+        ctx.restore();
     }
 
-    GetScreenHeight() {
-        return this.ctx.canvas.height;
+    // Executes the commands at the word indexes [start, end) of the current views
+    #executeCommands(start, end) {
+        const u32 = this.u32;
+        const i32 = this.i32;
+        const f32 = this.f32;
+        for (let i = start; i < end; i += u32[i]>>>8) {
+            switch (u32[i]&0xFF) {
+            case CMD_CLEAR_BACKGROUND:
+                this.#clearBackground(this.#color(u32[i + 1]));
+                break;
+            case CMD_DRAW_RECTANGLE:
+                this.#drawRectangle(f32[i + 1], f32[i + 2], f32[i + 3], f32[i + 4], this.#color(u32[i + 5]));
+                break;
+            case CMD_DRAW_RECTANGLE_LINES:
+                this.#drawRectangleLines(f32[i + 1], f32[i + 2], f32[i + 3], f32[i + 4], f32[i + 5], this.#color(u32[i + 6]));
+                break;
+            case CMD_DRAW_CIRCLE:
+                this.#drawCircle(f32[i + 1], f32[i + 2], f32[i + 3], this.#color(u32[i + 4]));
+                break;
+            case CMD_DRAW_TEXT:
+                this.#drawText(this.#cstr((i + 5)*4), i32[i + 1], i32[i + 2], i32[i + 3], this.#color(u32[i + 4]));
+                break;
+            case CMD_DRAW_TEXT_EX:
+                this.#drawTextEx(u32[i + 1], this.#cstr((i + 7)*4), f32[i + 2], f32[i + 3], f32[i + 4], f32[i + 5], this.#color(u32[i + 6]));
+                break;
+            case CMD_DRAW_TEXTURE:
+                this.#drawTexture(u32[i + 1], i32[i + 2], i32[i + 3], u32[i + 4]);
+                break;
+            case CMD_DRAW_TEXTURE_PRO:
+                this.#drawTexturePro(u32[i + 1], f32[i + 2], f32[i + 3], f32[i + 4], f32[i + 5],
+                                     f32[i + 6], f32[i + 7], f32[i + 8], f32[i + 9],
+                                     f32[i + 10], f32[i + 11], f32[i + 12], u32[i + 13]);
+                break;
+            case CMD_SET_TRANSFORM:
+                this.#applyTransform(f32[i + 1], f32[i + 2], f32[i + 3], f32[i + 4], f32[i + 5], f32[i + 6]);
+                break;
+            case CMD_BEGIN_LAYER:
+                this.#beginLayer(i32[i + 1]);
+                break;
+            case CMD_END_LAYER:
+                this.#endLayer();
+                break;
+            case CMD_DRAW_LAYER:
+                this.#drawLayer(i32[i + 1], i32[i + 2], i32[i + 3]);
+                break;
+            case CMD_UNLOAD_LAYER:
+                this.#unloadLayer(i32[i + 1]);
+                break;
+            case CMD_DRAW_BATCH: {
+                const draws = i + 3;
+                this.#drawBatch(draws, u32[i + 1], draws + u32[i + 1]*(BATCH_DRAW_SIZE>>2));
+            } break;
+            default:
+                throw new Error(`Unknown command ${u32[i]&0xFF} in the command buffer`);
+            }
+        }
     }
 
-    GetFrameTime() {
-        // TODO: This is a stopgap solution to prevent sudden jumps in dt when the user switches to a differen tab.
-        // We need a proper handling of Target FPS here.
-        return Math.min(this.dt, 1.0/this.targetFPS);
+    raylib_js_set_entry(entry) {
+        const entryFunction = this.exports.__indirect_function_table.get(entry);
+        // NOTE: the imports of JSPI can only be called under an export made promising, even when
+        // they don't suspend
+        this.entryFunction = this.jspi ? WebAssembly.promising(entryFunction) : entryFunction;
     }
+}
 
-    BeginDrawing() {}
-
-    EndDrawing() {
-        this.prevPressedKeyState.clear();
-        this.prevPressedKeyState = new Set(this.currentPressedKeyState);
-        this.currentMouseWheelMoveState = 0.0;
+// The SharedArrayBuffer between the page and the worker of the blocking mode. The game publishes
+// the commands of every frame into one of RING_SLOTS slots and only blocks when all of them are
+// still waiting for the page, so it simulates the next frame while the page presents the previous
+// one. The page presents one frame per tick and releases its slot, which is the vsync token the
+// game waits for. A frame that doesn't fit into a slot is published in parts.
+//
+// The page also publishes the input state in here for the game to take at the end of its frames,
+// guarded by a sequence number that is odd while the page is writing it.
+class FrameRing {
+    static create(slotCapacity = RING_DEFAULT_SLOT_CAPACITY) {
+        const ring = new FrameRing(new SharedArrayBuffer((RING_SLOTS_BEGIN + RING_SLOTS*slotCapacity)*4));
+        ring.i32[RING_SLOT_CAPACITY] = slotCapacity;
+        ring.slotCapacity = slotCapacity;
+        ring.setTargetFPS(60);
+        return ring;
     }
 
-    DrawCircleV(center_ptr, radius, color_ptr) {
-        const buffer = this.exports.memory.buffer;
-        const [x, y] = new Float32Array(buffer, center_ptr, 2);
-        const [r, g, b, a] = new Uint8Array(buffer, color_ptr, 4);
-        const color = color_hex_unpacked(r, g, b, a);
-        this.ctx.beginPath();
-        this.ctx.arc(x, y, radius, 0, 2*Math.PI, false);
-        this.ctx.fillStyle = color;
-        this.ctx.fill();
+    constructor(buffer) {
+        this.buffer = buffer;
+        this.u8 = new Uint8Array(buffer);
+        this.u32 = new Uint32Array(buffer);
+        this.i32 = new Int32Array(buffer);
+        this.f32 = new Float32Array(buffer);
+        this.f64 = new Float64Array(buffer);
+        this.slotCapacity = this.i32[RING_SLOT_CAPACITY];
+        this.fill = 0;   // of the slot the game is writing to
     }
 
-    ClearBackground(color_ptr) {
-        this.ctx.fillStyle = getColorFromMemory(this.exports.memory.buffer, color_ptr);
-        this.ctx.fillRect(0, 0, this.ctx.canvas.width, this.ctx.canvas.height);
+    targetFPS() {
+        return Atomics.load(this.i32, RING_TARGET_FPS);
     }
 
-    // RLAPI void DrawText(const char *text, int posX, int posY, int fontSize, Color color);       // Draw text (using default font)
-    DrawText(text_ptr, posX, posY, fontSize, color_ptr) {
-        const buffer = this.exports.memory.buffer;
-        const text = cstr_by_ptr(buffer, text_ptr);
-        const color = getColorFromMemory(buffer, color_ptr);
-        fontSize *= this.#FONT_SCALE_MAGIC;
-        this.ctx.fillStyle = color;
-        // TODO: since the default font is part of Raylib the css that defines it should be located in raylib.js and not in index.html
-        this.ctx.font = `${fontSize}px grixel`;
+    setTargetFPS(fps) {
+        Atomics.store(this.i32, RING_TARGET_FPS, fps);
+    }
 
-        const lines = text.split('\n');
-        for (var i = 0; i < lines.length; i++) {
-            this.ctx.fillText(lines[i], posX, posY + fontSize + (i * fontSize));
+    // Game side. Waits until the slot of the next frame is presented and returns where it begins.
+    #acquire() {
+        const published = this.i32[RING_PUBLISHED];
+        for (;;) {
+            const presented = Atomics.load(this.i32, RING_PRESENTED);
+            if (published - presented < RING_SLOTS) break;
+            Atomics.wait(this.i32, RING_PRESENTED, presented);
         }
+        return RING_SLOTS_BEGIN + (published%RING_SLOTS)*this.slotCapacity;
     }
 
-    // RLAPI void DrawRectangle(int posX, int posY, int width, int height, Color color);                        // Draw a color-filled rectangle
-    DrawRectangle(posX, posY, width, height, color_ptr) {
-        const buffer = this.exports.memory.buffer;
-        const color = getColorFromMemory(buffer, color_ptr);
-        this.ctx.fillStyle = color;
-        this.ctx.fillRect(posX, posY, width, height);
+    // Game side. Appends count words of the commands starting at words[begin] to the frame.
+    write(words, begin, count) {
+        if (this.fill + count > this.slotCapacity) this.publish(false);
+        const slot = this.#acquire();
+        this.u32.set(words.subarray(begin, begin + count), slot + this.fill);
+        this.fill += count;
     }
 
-    DrawRectangleV(position_ptr, size_ptr, color_ptr) {
-        const buffer = this.exports.memory.buffer;
-        const color = getColorFromMemory(buffer, color_ptr);
-        const position = new Float32Array(buffer, position_ptr, 2);
-        const size = new Float32Array(buffer, size_ptr, 2);
-        this.ctx.fillStyle = color;
-        this.ctx.fillRect(position[0], position[1], size[0], size[1]);
+    // Game side
+    publish(final) {
+        this.#acquire();
+        const published = this.i32[RING_PUBLISHED];
+        const header = RING_SLOT_HEADERS + (published%RING_SLOTS)*2;
+        this.i32[header] = this.fill;
+        this.i32[header + 1] = final ? 1 : 0;
+        this.fill = 0;
+        Atomics.store(this.i32, RING_PUBLISHED, published + 1);
     }
 
-    IsKeyPressed(key) {
-        return !this.prevPressedKeyState.has(key) && this.currentPressedKeyState.has(key);
+    // Page side. Calls execute(begin, end) for the word ranges of the next frame if it's there.
+    present(execute) {
+        let presented = this.i32[RING_PRESENTED];
+        while (presented < Atomics.load(this.i32, RING_PUBLISHED)) {
+            const slot = presented%RING_SLOTS;
+            const begin = RING_SLOTS_BEGIN + slot*this.slotCapacity;
+            execute(begin, begin + this.i32[RING_SLOT_HEADERS + slot*2]);
+            const final = this.i32[RING_SLOT_HEADERS + slot*2 + 1] !== 0;
+            presented += 1;
+            Atomics.store(this.i32, RING_PRESENTED, presented);
+            Atomics.notify(this.i32, RING_PRESENTED);
+            if (final) break;
+        }
     }
-    IsKeyDown(key) {
-        return this.currentPressedKeyState.has(key);
+
+    // Page side
+    writeInput(keys, mousePosition, wheel, events) {
+        const seq = this.i32[RING_INPUT_SEQ];
+        Atomics.store(this.i32, RING_INPUT_SEQ, seq + 1);
+        this.u8.set(keys, RING_INPUT_KEYS*4);
+        this.f32[RING_INPUT_MOUSE] = mousePosition.x;
+        this.f32[RING_INPUT_MOUSE + 1] = mousePosition.y;
+        this.f32[RING_INPUT_WHEEL] = wheel;
+        this.i32[RING_INPUT_EVENT_COUNT] = events.length;
+        for (let i = 0; i < events.length; ++i) {
+            const event = RING_INPUT_EVENTS + i*RING_EVENT_SIZE;
+            this.i32[event] = events[i].serial;
+            this.i32[event + 1] = events[i].type;
+            this.i32[event + 2] = events[i].value;
+            this.f64[(event + 4)>>1] = events[i].time;
+        }
+        Atomics.store(this.i32, RING_INPUT_SEQ, seq + 2);
     }
-    GetMouseWheelMove() {
-      return this.currentMouseWheelMoveState;
+
+    // Game side. Returns the input the page published since seq, if any.
+    readInput(seq) {
+        for (;;) {
+            const begin = Atomics.load(this.i32, RING_INPUT_SEQ);
+            if (begin === seq) return undefined;
+            if (begin%2 !== 0) continue;
+            const input = {
+                seq: begin,
+                keys: this.u8.slice(RING_INPUT_KEYS*4, RING_INPUT_KEYS*4 + INPUT_MAX_KEYS/8),
+                x: this.f32[RING_INPUT_MOUSE],
+                y: this.f32[RING_INPUT_MOUSE + 1],
+                wheel: this.f32[RING_INPUT_WHEEL],
+                events: [],
+            };
+            const count = Math.min(this.i32[RING_INPUT_EVENT_COUNT], INPUT_MAX_EVENTS);
+            for (let i = 0; i < count; ++i) {
+                const event = RING_INPUT_EVENTS + i*RING_EVENT_SIZE;
+                input.events.push({
+                    serial: this.i32[event],
+                    type: this.i32[event + 1],
+                    value: this.i32[event + 2],
+                    time: this.f64[(event + 4)>>1],
+                });
+            }
+            // The page started writing the next one while we were reading, try again
+            if (Atomics.load(this.i32, RING_INPUT_SEQ) === begin) return input;
+        }
     }
-    IsGestureDetected() {
-        return false;
+
+    // Game side. Tells the page which input events it doesn't have to publish anymore.
+    ackInput(serial) {
+        Atomics.store(this.i32, RING_INPUT_ACK, serial);
     }
 
-    TextFormat(... args){ 
-        // TODO: Implement printf style formatting for TextFormat
-        return args[0];
+    inputAck() {
+        return Atomics.load(this.i32, RING_INPUT_ACK);
     }
+}
 
-    TraceLog(logLevel, text_ptr, ... args) {
-        // TODO: Implement printf style formatting for TraceLog
-        const buffer = this.exports.memory.buffer;
-        const text = cstr_by_ptr(buffer, text_ptr);
-        switch(logLevel) {
-        case LOG_ALL:     console.log(`ALL: ${text} ${args}`);     break;
-        case LOG_TRACE:   console.log(`TRACE: ${text} ${args}`);   break;
-        case LOG_DEBUG:   console.log(`DEBUG: ${text} ${args}`);   break;
-        case LOG_INFO:    console.log(`INFO: ${text} ${args}`);    break;
-        case LOG_WARNING: console.log(`WARNING: ${text} ${args}`); break;
-        case LOG_ERROR:   console.log(`ERROR: ${text} ${args}`);   break;
-        case LOG_FATAL:   throw new Error(`FATAL: ${text}`);
-        case LOG_NONE:    console.log(`NONE: ${text} ${args}`);    break;
+// The resources the game refers to by ids, like the textures and the fonts. The lower 16 bits of an
+// id are the index of its slot + 1, so 0 is never valid as in raylib, and the upper 16 bits are the
+// generation of the slot. It changes whenever the slot is freed, so the id of an unloaded resource
+// never refers to whatever reuses its slot.
+class ResourceSlots {
+    constructor() {
+        this.items = [];
+        this.ids = [];          // of every slot, 0 while it's free
+        this.generations = [];
+        this.free = [];         // slots
+        this.count = 0;
+    }
+
+    add(item) {
+        let slot = this.free.pop();
+        if (slot === undefined) {
+            slot = this.items.length;
+            if (slot >= 0xFFFF) throw new Error("Too many resources loaded at the same time");
+            this.#grow(slot + 1);
         }
+        const id = ((this.generations[slot] << 16) | (slot + 1))>>>0;
+        this.ids[slot] = id;
+        this.items[slot] = item;
+        this.count += 1;
+        return id;
     }
 
-    GetMousePosition(result_ptr) {
-        const bcrect = this.ctx.canvas.getBoundingClientRect();
-        const x = this.currentMousePosition.x - bcrect.left;
-        const y = this.currentMousePosition.y - bcrect.top;
+    // For the page of the blocking mode, which gets the ids from the worker
+    put(id, item) {
+        const slot = (id&0xFFFF) - 1;
+        this.#grow(slot + 1);
+        if (this.ids[slot] === 0) this.count += 1;
+        this.ids[slot] = id;
+        this.items[slot] = item;
+    }
 
-        const buffer = this.exports.memory.buffer;
-        new Float32Array(buffer, result_ptr, 2).set([x, y]);
+    get(id) {
+        const slot = (id&0xFFFF) - 1;
+        return this.ids[slot] === id ? this.items[slot] : undefined;
     }
 
-    CheckCollisionPointRec(point_ptr, rec_ptr) {
-        const buffer = this.exports.memory.buffer;
-        const [x, y] = new Float32Array(buffer, point_ptr, 2);
-        const [rx, ry, rw, rh] = new Float32Array(buffer, rec_ptr, 4);
-        return ((x >= rx) && x <= (rx + rw) && (y >= ry) && y <= (ry + rh));
+    // Returns the item, or undefined if the id is not valid anymore
+    remove(id) {
+        const slot = (id&0xFFFF) - 1;
+        if (this.ids[slot] !== id) return undefined;
+        const item = this.items[slot];
+        this.items[slot] = undefined;
+        this.ids[slot] = 0;
+        this.generations[slot] = (this.generations[slot] + 1)&0xFFFF;
+        this.free.push(slot);
+        this.count -= 1;
+        return item;
     }
 
-    Fade(result_ptr, color_ptr, alpha) {
-        const buffer = this.exports.memory.buffer;
-        const [r, g, b, _] = new Uint8Array(buffer, color_ptr, 4);
-        const newA = Math.max(0, Math.min(255, 255.0*alpha));
-        new Uint8Array(buffer, result_ptr, 4).set([r, g, b, newA]);
+    *values() {
+        for (let slot = 0; slot < this.items.length; ++slot) {
+            if (this.ids[slot] !== 0) yield this.items[slot];
+        }
     }
 
-    DrawRectangleRec(rec_ptr, color_ptr) {
-        const buffer = this.exports.memory.buffer;
-        const [x, y, w, h] = new Float32Array(buffer, rec_ptr, 4);
-        const color = getColorFromMemory(buffer, color_ptr);
-        this.ctx.fillStyle = color;
-        this.ctx.fillRect(x, y, w, h);
+    #grow(length) {
+        while (this.items.length < length) {
+            this.items.push(undefined);
+            this.ids.push(0);
+            this.generations.push(0);
+        }
     }
+}
 
-    DrawRectangleLinesEx(rec_ptr, lineThick, color_ptr) {
-        const buffer = this.exports.memory.buffer;
-        const [x, y, w, h] = new Float32Array(buffer, rec_ptr, 4);
-        const color = getColorFromMemory(buffer, color_ptr);
-        this.ctx.strokeStyle = color;
-        this.ctx.lineWidth = lineThick;
-        this.ctx.strokeRect(x + lineThick/2, y + lineThick/2, w - lineThick, h - lineThick);
+// A few workers that fetch and decode images with createImageBitmap(), so neither ever blocks the
+// thread the game runs on. The decoded ImageBitmaps are transferred back without copying.
+class ImageDecoderPool {
+    static #MAX_WORKERS = 4;
+    static #instance = undefined;
+
+    static shared() {
+        if (ImageDecoderPool.#instance === undefined) {
+            const size = Math.min(navigator.hardwareConcurrency ?? 2, ImageDecoderPool.#MAX_WORKERS);
+            ImageDecoderPool.#instance = new ImageDecoderPool(size);
+        }
+        return ImageDecoderPool.#instance;
     }
 
-    MeasureText(text_ptr, fontSize) {
-        const buffer = this.exports.memory.buffer;
-        const text = cstr_by_ptr(buffer, text_ptr);
-        fontSize *= this.#FONT_SCALE_MAGIC;
-        this.ctx.font = `${fontSize}px grixel`;
-        return this.ctx.measureText(text).width;
+    constructor(size) {
+        this.workers = [];
+        this.next = 0;
+        this.pending = new Map();   // id -> {resolve, reject}
+        this.lastId = 0;
+        // NOTE: without workers, createImageBitmap() still decodes off the thread in most browsers
+        if (typeof Worker === "undefined") return;
+        const source = `${decode_image.toString()}
+onmessage = async (e) => {
+    const {id, url} = e.data;
+    try {
+        const decoded = await decode_image(url);
+        postMessage({id, ...decoded}, [decoded.bitmap]);
+    } catch (error) {
+        postMessage({id, error: String(error)});
+    }
+};`;
+        const url = URL.createObjectURL(new Blob([source], {type: "text/javascript"}));
+        for (let i = 0; i < size; ++i) {
+            const worker = new Worker(url);
+            worker.onmessage = (e) => this.#done(e.data);
+            this.workers.push(worker);
+        }
     }
 
-    TextSubtext(text_ptr, position, length) {
-        const buffer = this.exports.memory.buffer;
-        const text = cstr_by_ptr(buffer, text_ptr);
-        const subtext = text.substring(position, length);
+    // Resolves to {bitmap, fetchTime, decodeTime}
+    decode(url) {
+        if (this.workers.length === 0) return decode_image(url);
+        return new Promise((resolve, reject) => {
+            const id = ++this.lastId;
+            this.pending.set(id, {resolve, reject});
+            this.workers[this.next].postMessage({id, url});
+            this.next = (this.next + 1)%this.workers.length;
+        });
+    }
 
-        var bytes = new Uint8Array(buffer, 0, subtext.length+1);
-        for(var i = 0; i < subtext.length; i++) {
-            bytes[i] = subtext.charCodeAt(i);
+    #done({id, error, ...decoded}) {
+        const {resolve, reject} = this.pending.get(id);
+        this.pending.delete(id);
+        if (error !== undefined) {
+            reject(new Error(error));
+        } else {
+            resolve(decoded);
         }
-        bytes[subtext.length] = 0;
+    }
+}
 
-        return bytes;
+// Copies of the textures multiplied by the colors they are drawn with, so a tinted draw is a single
+// drawImage() just like an untinted one. Only the RGB of the tint makes a copy, its alpha is applied
+// when drawing, so fading a sprite in and out does not make a new one every frame. The least
+// recently used copies are closed once all of them take more than the budget.
+class TintCache {
+    constructor(budget, stats) {
+        this.budget = budget;
+        this.stats = stats;
+        this.entries = new Map();   // slot of the texture*2^24 + rgb -> {id, source, version, bitmap}
+        this.canvas = undefined;
+        this.ctx = undefined;
     }
 
-    // RLAPI Texture2D LoadTexture(const char *fileName);
-    LoadTexture(result_ptr, filename_ptr) {
-        const buffer = this.exports.memory.buffer;
-        const filename = cstr_by_ptr(buffer, filename_ptr);
+    get(id, source, version, rgb) {
+        const key = (id&0xFFFF)*0x1000000 + rgb;
+        const entry = this.entries.get(key);
+        if (entry !== undefined) {
+            // Most recently used go last
+            this.entries.delete(key);
+            this.entries.set(key, entry);
+            if (entry.id === id && entry.source === source && entry.version === version) {
+                this.stats.tintCacheHits += 1;
+                return entry.bitmap;
+            }
+            // The slot of the texture has been reused or its pixels have changed since
+            this.#close(key, entry);
+        }
+        this.stats.tintCacheMisses += 1;
+        const bitmap = this.#tint(source, rgb);
+        this.entries.set(key, {id, source, version, bitmap});
+        this.stats.tintCacheBytes += bitmap_bytes(bitmap);
+        for (const [oldest, old] of this.entries) {
+            if (this.stats.tintCacheBytes <= this.budget || old.bitmap === bitmap) break;
+            this.#close(oldest, old);
+        }
+        return bitmap;
+    }
 
-        var result = new Uint32Array(buffer, result_ptr, 5)
-        var img = new Image();
-        img.src = filename;
-        this.images.push(img);
+    forget(id) {
+        for (const [key, entry] of this.entries) {
+            if (entry.id === id) this.#close(key, entry);
+        }
+    }
 
-        result[0] = this.images.indexOf(img);
-        // TODO: get the true width and height of the image
-        result[1] = 256; // width
-        result[2] = 256; // height
-        result[3] = 1; // mipmaps
-        result[4] = 7; // format PIXELFORMAT_UNCOMPRESSED_R8G8B8A8
+    clear() {
+        for (const [key, entry] of this.entries) this.#close(key, entry);
+    }
 
-        return result;
+    #close(key, entry) {
+        this.entries.delete(key);
+        this.stats.tintCacheBytes -= bitmap_bytes(entry.bitmap);
+        entry.bitmap.close();
     }
 
-    // RLAPI void DrawTexture(Texture2D texture, int posX, int posY, Color tint);
-    DrawTexture(texture_ptr, posX, posY, color_ptr) {
-        const buffer = this.exports.memory.buffer;
-        const [id, width, height, mipmaps, format] = new Uint32Array(buffer, texture_ptr, 5);
-        // // TODO: implement tinting for DrawTexture
-        // const tint = getColorFromMemory(buffer, color_ptr);
+    // Multiplies every pixel like the tint does in raylib. Compositing the color over the image
+    // on the canvas would be faster, but the blend modes don't get the semitransparent edges right.
+    #tint(source, rgb) {
+        if (this.canvas === undefined) {
+            this.canvas = new OffscreenCanvas(source.width, source.height);
+            this.ctx = this.canvas.getContext("2d", {willReadFrequently: true});
+        }
+        this.canvas.width = source.width;
+        this.canvas.height = source.height;
+        this.ctx.drawImage(source, 0, 0);
+        const pixels = this.ctx.getImageData(0, 0, source.width, source.height);
+        const data = pixels.data;
+        const r = rgb&0xFF;
+        const g = (rgb>>8)&0xFF;
+        const b = (rgb>>16)&0xFF;
+        for (let i = 0; i < data.length; i += 4) {
+            data[i + 0] = data[i + 0]*r/255;
+            data[i + 1] = data[i + 1]*g/255;
+            data[i + 2] = data[i + 2]*b/255;
+        }
+        this.ctx.putImageData(pixels, 0, 0);
+        return this.canvas.transferToImageBitmap();
+    }
+}
+
+// An atlas of white glyphs in an offscreen canvas. Every color the text is drawn with gets its
+// own tinted copy of the atlas, the ones used least recently are dropped past #MAX_TINTS.
+class TintableAtlas {
+    static #MAX_TINTS = 8;
 
-        this.ctx.drawImage(this.images[id], posX, posY);
+    constructor(width, height) {
+        this.canvas = new OffscreenCanvas(width, height);
+        this.ctx = this.canvas.getContext("2d");
+        // Bumped whenever the atlas changes, so the tinted copies know to refresh themselves
+        this.version = 0;
+        this.tints = new Map();   // color -> {canvas, ctx, version}
     }
 
-    // TODO: codepoints are not implemented
-    LoadFontEx(result_ptr, fileName_ptr/*, fontSize, codepoints, codepointCount*/) {
-        const buffer = this.exports.memory.buffer;
-        const fileName = cstr_by_ptr(buffer, fileName_ptr);
-        // TODO: dynamically generate the name for the font
-        // Support more than one custom font
-        const font = new FontFace("myfont", `url(${fileName})`);
-        document.fonts.add(font);
-        font.load();
+    tinted(color) {
+        let tint = this.tints.get(color);
+        if (tint !== undefined) {
+            this.tints.delete(color);
+        } else {
+            if (this.tints.size >= TintableAtlas.#MAX_TINTS) {
+                const [oldest, evicted] = this.tints.entries().next().value;
+                release_canvas(evicted.canvas);
+                this.tints.delete(oldest);
+            }
+            const canvas = new OffscreenCanvas(this.canvas.width, this.canvas.height);
+            tint = {canvas, ctx: canvas.getContext("2d"), version: -1};
+        }
+        this.tints.set(color, tint);
+        if (tint.version !== this.version) {
+            tint.ctx.globalCompositeOperation = "copy";
+            tint.ctx.drawImage(this.canvas, 0, 0);
+            tint.ctx.globalCompositeOperation = "source-in";
+            tint.ctx.fillStyle = color;
+            tint.ctx.fillRect(0, 0, this.canvas.width, this.canvas.height);
+            tint.version = this.version;
+        }
+        return tint.canvas;
     }
 
-    GenTextureMipmaps() {}
-    SetTextureFilter() {}
+    // Frees the pixels right away instead of whenever the canvases are collected
+    release() {
+        for (const tint of this.tints.values()) release_canvas(tint.canvas);
+        this.tints.clear();
+        release_canvas(this.canvas);
+    }
+}
 
-    MeasureTextEx(result_ptr, font, text_ptr, fontSize, spacing) {
-        const buffer = this.exports.memory.buffer;
-        const text = cstr_by_ptr(buffer, text_ptr);
-        const result = new Float32Array(buffer, result_ptr, 2);
-        this.ctx.font = fontSize+"px myfont";
-        const metrics = this.ctx.measureText(text)
-        result[0] = metrics.width;
-        result[1] = fontSize;
+// All the glyphs of a single CSS font (family and size) rasterized once into an offscreen canvas,
+// so drawing text is just a run of drawImage() blits instead of shaping it with fillText() every
+// frame. The atlas is sized for about 256 glyphs of the font.
+// NOTE: glyphs are positioned by their advances, so kerning is lost.
+class GlyphAtlas extends TintableAtlas {
+    static #MAX_SIZE = 2048;
+
+    constructor(font, size) {
+        const probe = new OffscreenCanvas(1, 1).getContext("2d");
+        probe.font = font;
+        const metrics = probe.measureText("Mg");
+        const ascent = Math.ceil(metrics.fontBoundingBoxAscent);
+        // The ink of a glyph may stick out of its advance box
+        const padding = Math.ceil(metrics.fontBoundingBoxAscent/4);
+        const cellHeight = ascent + Math.ceil(metrics.fontBoundingBoxDescent) + 2*padding;
+        let atlasSize = 64;
+        while (atlasSize < 16*cellHeight && atlasSize < GlyphAtlas.#MAX_SIZE) atlasSize *= 2;
+        super(atlasSize, atlasSize);
+        this.ctx.font = font;
+        this.ctx.fillStyle = "#ffffff";
+        this.size = size;         // The font size the glyphs are rasterized at
+        this.atlasSize = atlasSize;
+        this.ascent = ascent;
+        this.padding = padding;
+        this.cellHeight = cellHeight;
+        this.glyphs = new Map();  // codepoint -> {x, y, width, advance}
+        this.cursorX = 0;
+        this.cursorY = 0;
+        this.resets = 0;
     }
 
-    DrawTextEx(font, text_ptr, position_ptr, fontSize, spacing, tint_ptr) {
-        const buffer = this.exports.memory.buffer;
-        const text = cstr_by_ptr(buffer, text_ptr);
-        const [posX, posY] = new Float32Array(buffer, position_ptr, 2);
-        const tint = getColorFromMemory(buffer, tint_ptr);
-        this.ctx.fillStyle = tint;
-        this.ctx.font = fontSize+"px myfont";
-        this.ctx.fillText(text, posX, posY + fontSize);
+    #glyph(codepoint) {
+        let glyph = this.glyphs.get(codepoint);
+        if (glyph !== undefined) return glyph;
+
+        const char = String.fromCodePoint(codepoint);
+        const advance = this.ctx.measureText(char).width;
+        const width = Math.ceil(advance) + 2*this.padding;
+        if (width > this.atlasSize) return undefined;
+        if (this.cursorX + width > this.atlasSize) {
+            this.cursorX = 0;
+            this.cursorY += this.cellHeight;
+        }
+        if (this.cursorY + this.cellHeight > this.atlasSize) {
+            // Out of space. Start over, only the glyphs that are still in use will come back.
+            this.ctx.clearRect(0, 0, this.atlasSize, this.atlasSize);
+            this.glyphs.clear();
+            this.cursorX = 0;
+            this.cursorY = 0;
+            this.resets += 1;
+        }
+        glyph = {x: this.cursorX, y: this.cursorY, width, advance};
+        this.ctx.fillText(char, glyph.x + this.padding, glyph.y + this.padding + this.ascent);
+        this.glyphs.set(codepoint, glyph);
+        this.cursorX += width;
+        this.version += 1;
+        return glyph;
     }
 
-    GetRandomValue(min, max) {
-        return min + Math.floor(Math.random()*(max - min + 1));
+    // Rasterizes the missing glyphs of the text. False if they don't all fit into the atlas at once.
+    #prepare(text) {
+        const resets = this.resets;
+        for (let i = 0; i < text.length; ++i) {
+            const codepoint = text.codePointAt(i);
+            if (codepoint > 0xFFFF) ++i;
+            if (codepoint !== 10 && this.#glyph(codepoint) === undefined) return false;
+        }
+        return this.resets === resets;
     }
 
-    ColorFromHSV(result_ptr, hue, saturation, value) {
-        const buffer = this.exports.memory.buffer;
-        const result = new Uint8Array(buffer, result_ptr, 4);
+    // Draws the text of the given font size with the baseline of its first line at y. '\n' starts
+    // a new line lineHeight below the previous one. False if the glyphs of the text don't fit
+    // into the atlas, then nothing is drawn and the text has to be drawn with fillText().
+    draw(ctx, text, x, y, fontSize, lineHeight, color) {
+        // The atlas may have started over halfway, dropping the glyphs from before. Once the text
+        // went through without that, all its glyphs are in the atlas.
+        if (!this.#prepare(text) && !this.#prepare(text)) return false;
 
-        // Red channel
-        let k = (5.0 + hue/60.0)%6;
-        let t = 4.0 - k;
-        k = (t < k)? t : k;
-        k = (k < 1)? k : 1;
-        k = (k > 0)? k : 0;
-        result[0] = Math.floor((value - value*saturation*k)*255.0);
+        // Only now, so the tinted atlas has all the glyphs and is refreshed once
+        const atlas = this.tinted(color);
+        const scale = fontSize/this.size;
+        const ascent = this.ascent*scale;
+        const padding = this.padding*scale;
+        const cellHeight = this.cellHeight*scale;
+        let penX = x;
+        let penY = y;
+        for (let i = 0; i < text.length; ++i) {
+            const codepoint = text.codePointAt(i);
+            if (codepoint > 0xFFFF) ++i;
+            if (codepoint === 10) {
+                penX = x;
+                penY += lineHeight;
+                continue;
+            }
+            const glyph = this.glyphs.get(codepoint);
+            ctx.drawImage(atlas,
+                          glyph.x, glyph.y, glyph.width, this.cellHeight,
+                          penX - padding, penY - ascent - padding, glyph.width*scale, cellHeight);
+            penX += glyph.advance*scale;
+        }
+        return true;
+    }
+}
 
-        // Green channel
-        k = (3.0 + hue/60.0)%6;
-        t = 4.0 - k;
-        k = (t < k)? t : k;
-        k = (k < 1)? k : 1;
-        k = (k > 0)? k : 0;
-        result[1] = Math.floor((value - value*saturation*k)*255.0);
+// The default font of raylib baked into the module by a RAYLIB_JS_DEFAULT_FONT build. The layout
+// is RaylibJsDefaultFont of src/raylib_js.h. The text is laid out exactly like DrawTextEx() of
+// raylib does it.
+class DefaultFontAtlas extends TintableAtlas {
+    constructor(mem, font_ptr) {
+        const i32 = new Int32Array(mem.buffer);
+        const width = i32[(font_ptr>>2) + 2];
+        const height = i32[(font_ptr>>2) + 3];
+        super(width, height);
+        this.baseSize = i32[font_ptr>>2];
+        this.glyphCount = i32[(font_ptr>>2) + 1];
 
-        // Blue channel
-        k = (1.0 + hue/60.0)%6;
-        t = 4.0 - k;
-        k = (t < k)? t : k;
-        k = (k < 1)? k : 1;
-        k = (k > 0)? k : 0;
-        result[2] = Math.floor((value - value*saturation*k)*255.0);
+        const atlas = new Uint32Array(mem.buffer, font_ptr + 16, width*height/32);
+        const pixels = new ImageData(width, height);
+        for (let i = 0; i < width*height; ++i) {
+            if ((atlas[i>>5]>>(i&31))&1) pixels.data.fill(255, i*4, i*4 + 4);
+        }
+        this.ctx.putImageData(pixels, 0, 0);
+        // NOTE: copied, so it survives memory.grow() detaching the buffer
+        this.recs = new Float32Array(mem.buffer, font_ptr + 16 + atlas.byteLength, this.glyphCount*4).slice();
+    }
 
-        result[3] = 255;
+    #glyphIndex(codepoint) {
+        const index = codepoint - 32;
+        return (index >= 0 && index < this.glyphCount) ? index : 63 - 32; // '?'
     }
 
-    raylib_js_set_entry(entry) {
-        this.entryFunction = this.exports.__indirect_function_table.get(entry);
+    draw(ctx, text, x, y, fontSize, spacing, color) {
+        const atlas = this.tinted(color);
+        const scale = fontSize/this.baseSize;
+        let offsetX = 0;
+        let offsetY = 0;
+        for (let i = 0; i < text.length; ++i) {
+            const codepoint = text.codePointAt(i);
+            if (codepoint > 0xFFFF) ++i;
+            if (codepoint === 10) {
+                offsetX = 0;
+                offsetY += fontSize + DEFAULT_FONT_LINE_SPACING;
+                continue;
+            }
+            const rec = this.#glyphIndex(codepoint)*4;
+            const w = this.recs[rec + 2];
+            const h = this.recs[rec + 3];
+            if (codepoint !== 32 && codepoint !== 9) {
+                ctx.drawImage(atlas, this.recs[rec], this.recs[rec + 1], w, h, x + offsetX, y + offsetY, w*scale, h*scale);
+            }
+            offsetX += w*scale + spacing;
+        }
     }
 }
 
@@ -528,28 +3195,63 @@ const glfwKeyMapping = {
     //  GLFW_KEY_LAST   GLFW_KEY_MENU
 }
 
-function cstrlen(mem, ptr) {
-    let len = 0;
-    while (mem[ptr] != 0) {
-        len++;
-        ptr++;
-    }
-    return len;
+// The assets are loaded relative to the page, or to the worker script in the worker mode
+function asset_url(path) {
+    return new URL(path, IS_WORKER ? location.href : document.baseURI).href;
 }
 
-function cstr_by_ptr(mem_buffer, ptr) {
-    const mem = new Uint8Array(mem_buffer);
-    const len = cstrlen(mem, ptr);
-    const bytes = new Uint8Array(mem_buffer, ptr, len);
-    return new TextDecoder().decode(bytes);
+// Shrinking a canvas frees its pixels right away, its memory may be outside of the JS heap
+function release_canvas(canvas) {
+    canvas.width = 0;
+    canvas.height = 0;
 }
 
-function color_hex_unpacked(r, g, b, a) {
-    r = r.toString(16).padStart(2, '0');
-    g = g.toString(16).padStart(2, '0');
-    b = b.toString(16).padStart(2, '0');
-    a = a.toString(16).padStart(2, '0');
-    return "#"+r+g+b+a;
+// What an ImageBitmap takes in the memory of the GPU or the process
+function bitmap_bytes(bitmap) {
+    return bitmap.width*bitmap.height*4;
+}
+
+// Fetches and decodes an image. Runs on the workers of ImageDecoderPool, so it must not use
+// anything from the outside.
+async function decode_image(url) {
+    const start = performance.now();
+    const response = await fetch(url);
+    if (!response.ok) throw new Error(`${url}: ${response.status} ${response.statusText}`);
+    const blob = await response.blob();
+    const fetched = performance.now();
+    const bitmap = await createImageBitmap(blob);
+    return {bitmap, fetchTime: fetched - start, decodeTime: performance.now() - fetched};
+}
+
+// The fonts of the page, or of the worker we are running in
+function font_face_set() {
+    return IS_WORKER ? self.fonts : document.fonts;
+}
+
+function key_bit(state, key) {
+    return key > 0 && key < INPUT_MAX_KEYS && ((state[key>>3]>>(key&7))&1) === 1;
+}
+
+const utf8Decoder = new TextDecoder();
+
+// Strings up to this length that are pure ASCII are decoded without TextDecoder. For such short
+// strings the call into the decoder costs more than building the string ourselves.
+const ASCII_FAST_PATH_MAX_LENGTH = 64;
+
+function utf8_decode(mem, begin, end, ascii) {
+    if (ascii && end - begin <= ASCII_FAST_PATH_MAX_LENGTH) {
+        let text = "";
+        for (let i = begin; i < end; ++i) text += String.fromCharCode(mem[i]);
+        return text;
+    }
+    // NOTE: TextDecoder refuses the views of a SharedArrayBuffer
+    return utf8Decoder.decode(mem.buffer instanceof ArrayBuffer ? mem.subarray(begin, end) : mem.slice(begin, end));
+}
+
+function cstr_by_ptr(mem, ptr) {
+    let end = mem.indexOf(0, ptr);
+    if (end < 0) end = mem.length;
+    return utf8Decoder.decode(mem.subarray(ptr, end));
 }
 
 function color_hex(color) {
@@ -559,8 +3261,3 @@ function color_hex(color) {
     const a = ((color>>(3*8))&0xFF).toString(16).padStart(2, '0');
     return "#"+r+g+b+a;
 }
-
-function getColorFromMemory(buffer, color_ptr) {
-    const [r, g, b, a] = new Uint8Array(buffer, color_ptr, 4);
-    return color_hex_unpacked(r, g, b, a);
-}
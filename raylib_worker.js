@@ -0,0 +1,3 @@
+// The worker of the worker mode of raylib.js. See the worker option of RaylibJs.start().
+importScripts("raylib.js");
+RaylibJs.runWorker();
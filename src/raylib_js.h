@@ -0,0 +1,230 @@
+// Declarations shared by the C side of raylib.js. Everything in here is only used by PLATFORM_WEB
+// builds and its layout has to be kept in sync with raylib.js.
+#ifndef RAYLIB_JS_H_
+#define RAYLIB_JS_H_
+
+#define RAYLIB_JS_EXPORT(name) __attribute__((export_name(#name)))
+
+//----------------------------------------------------------------------------------
+// Command buffer (RAYLIB_JS_COMMAND_BUFFER)
+//----------------------------------------------------------------------------------
+// Every command starts with a header word: the opcode in the lowest 8 bits and the size of the
+// whole command in words (including the header) in the rest. The arguments follow the header
+// as 32-bit words: floats, ints and Colors packed as 0xAABBGGRR. Text is copied into the
+// command as a NUL-terminated string padded to the word boundary.
+typedef enum {
+    RAYLIB_JS_CMD_CLEAR_BACKGROUND = 0,   // color
+    RAYLIB_JS_CMD_DRAW_RECTANGLE,         // f32 x, f32 y, f32 w, f32 h, color
+    RAYLIB_JS_CMD_DRAW_RECTANGLE_LINES,   // f32 x, f32 y, f32 w, f32 h, f32 lineThick, color
+    RAYLIB_JS_CMD_DRAW_CIRCLE,            // f32 x, f32 y, f32 radius, color
+    RAYLIB_JS_CMD_DRAW_TEXT,              // i32 x, i32 y, i32 fontSize, color, text
+    RAYLIB_JS_CMD_DRAW_TEXT_EX,           // u32 font, f32 x, f32 y, f32 fontSize, f32 spacing, color, text
+    RAYLIB_JS_CMD_DRAW_TEXTURE,           // u32 id, i32 x, i32 y, color
+    RAYLIB_JS_CMD_DRAW_TEXTURE_PRO,       // u32 id, f32 source x, y, w, h, f32 dest x, y, w, h, f32 origin x, y, f32 rotation, color
+    RAYLIB_JS_CMD_SET_TRANSFORM,          // f32 a, b, c, d, e, f as in RaylibJsTransform
+    RAYLIB_JS_CMD_BEGIN_LAYER,            // i32 id
+    RAYLIB_JS_CMD_END_LAYER,              //
+    RAYLIB_JS_CMD_DRAW_LAYER,             // i32 id, i32 x, i32 y
+    RAYLIB_JS_CMD_UNLOAD_LAYER,           // i32 id
+    RAYLIB_JS_CMD_DRAW_BATCH,             // u32 drawCount, u32 vertexCount, the draws and the vertices of RaylibJsRenderBatch
+} RaylibJsCommandOp;
+
+#ifndef RAYLIB_JS_COMMAND_BUFFER_CAPACITY
+#define RAYLIB_JS_COMMAND_BUFFER_CAPACITY (64*1024)   // in words
+#endif
+
+typedef union {
+    unsigned int u;
+    int i;
+    float f;
+} RaylibJsWord;
+
+typedef struct {
+    unsigned int count;      // Words currently recorded
+    unsigned int capacity;   // Words available in words[]
+    RaylibJsWord words[RAYLIB_JS_COMMAND_BUFFER_CAPACITY];
+} RaylibJsCommandBuffer;
+
+RaylibJsCommandBuffer *raylib_js_command_buffer(void);
+
+// Implemented by raylib.js. Executes all the recorded commands and empties the buffer.
+void raylib_js_flush_commands(void);
+
+//----------------------------------------------------------------------------------
+// Layers
+//----------------------------------------------------------------------------------
+// A layer is a canvas of the size of the screen that static content is drawn into once and then
+// drawn from every frame with a single drawImage(). BeginLayer() returns true when the layer has
+// to be recorded, because it has never been or it was marked dirty since, and then everything up
+// to EndLayer() is drawn into the layer instead of the screen:
+//
+//     if (BeginLayer(BACKGROUND)) {
+//         ...
+//         EndLayer();
+//     }
+//     DrawLayer(BACKGROUND, 0, 0);
+//
+// Implemented by raylib.js, or recorded as commands by RAYLIB_JS_COMMAND_BUFFER builds, which keep
+// whether the layers are dirty for the ids from 0 to RAYLIB_JS_MAX_LAYERS - 1 and ignore the others
+// with a warning.
+#ifndef RAYLIB_JS_MAX_LAYERS
+#define RAYLIB_JS_MAX_LAYERS 64
+#endif
+
+bool BeginLayer(int id);
+void EndLayer(void);
+void DrawLayer(int id, int posX, int posY);
+void MarkLayerDirty(int id);
+void UnloadLayer(int id);
+
+//----------------------------------------------------------------------------------
+// Default font (RAYLIB_JS_DEFAULT_FONT)
+//----------------------------------------------------------------------------------
+// The default font of raylib baked by nob.c at build time. The atlas is 1 bit per pixel: bit j of
+// atlas[k] is the pixel 32*k + j, counting row by row. The glyphs are the codepoints starting from
+// ' ' in order.
+#define RAYLIB_JS_DEFAULT_FONT_BASE_SIZE    10
+#define RAYLIB_JS_DEFAULT_FONT_GLYPH_COUNT  224
+#define RAYLIB_JS_DEFAULT_FONT_ATLAS_SIZE   128
+#define RAYLIB_JS_DEFAULT_FONT_LINE_SPACING 2
+
+typedef struct {
+    int baseSize;
+    int glyphCount;
+    int atlasWidth;
+    int atlasHeight;
+    unsigned int atlas[RAYLIB_JS_DEFAULT_FONT_ATLAS_SIZE*RAYLIB_JS_DEFAULT_FONT_ATLAS_SIZE/32];
+    Rectangle recs[RAYLIB_JS_DEFAULT_FONT_GLYPH_COUNT];
+} RaylibJsDefaultFont;
+
+const RaylibJsDefaultFont *raylib_js_default_font(void);
+
+// Decodes the next UTF-8 codepoint of text and advances it. Invalid sequences decode as '?'.
+int raylib_js_next_codepoint(const unsigned char **text);
+
+//----------------------------------------------------------------------------------
+// Transform of the 2D drawing
+//----------------------------------------------------------------------------------
+// BeginMode2D() and the matrix stack of rlgl are computed in wasm. The 2D part of the current
+// matrix is kept here as the arguments of ctx.setTransform(): a point (x, y) is drawn at
+// (a*x + c*y + e, b*x + d*y + f). version changes whenever the matrix does, so raylib.js only
+// reads it again after a change. raylib.js writes the size of the screen at InitWindow().
+#ifndef RAYLIB_JS_SOFTWARE_RENDERER
+
+#ifndef RAYLIB_JS_MATRIX_STACK_SIZE
+#define RAYLIB_JS_MATRIX_STACK_SIZE 32      // Same as RL_MAX_MATRIX_STACK_SIZE of rlgl
+#endif
+
+typedef struct {
+    unsigned int version;
+    float a, b, c, d, e, f;
+    int screenWidth;
+    int screenHeight;
+    unsigned int culled;    // Draws skipped by raylib_js_visible(), raylib.js resets it every frame
+} RaylibJsTransform;
+
+RaylibJsTransform *raylib_js_transform(void);
+
+// Whether anything within the bounds, in the coordinates of the current matrix, ends up on the
+// screen. Counts the draws it returns false for as culled.
+bool raylib_js_visible(Rectangle bounds);
+
+#endif // RAYLIB_JS_SOFTWARE_RENDERER
+
+//----------------------------------------------------------------------------------
+// Software renderer (RAYLIB_JS_SOFTWARE_RENDERER)
+//----------------------------------------------------------------------------------
+// The frame is rasterized into pixels[] as RGBA bytes, the same layout as the data of an
+// ImageData, and raylib.js puts it on the canvas at EndDrawing(). raylib.js sets the width and
+// the height at InitWindow(), and width*height never exceeds the capacity.
+#ifdef RAYLIB_JS_SOFTWARE_RENDERER
+#ifdef RAYLIB_JS_COMMAND_BUFFER
+#error "RAYLIB_JS_SOFTWARE_RENDERER and RAYLIB_JS_COMMAND_BUFFER can't be enabled together"
+#endif
+#ifndef RAYLIB_JS_DEFAULT_FONT
+#error "RAYLIB_JS_SOFTWARE_RENDERER draws text with the default font and requires RAYLIB_JS_DEFAULT_FONT"
+#endif
+#endif
+
+#ifndef RAYLIB_JS_FRAMEBUFFER_CAPACITY
+#define RAYLIB_JS_FRAMEBUFFER_CAPACITY (1920*1080)        // in pixels
+#endif
+
+#ifndef RAYLIB_JS_SOFTWARE_MAX_TEXTURES
+#define RAYLIB_JS_SOFTWARE_MAX_TEXTURES 256
+#endif
+
+// The pixels of the textures loaded from files are copied here
+#ifndef RAYLIB_JS_SOFTWARE_TEXTURE_ARENA
+#define RAYLIB_JS_SOFTWARE_TEXTURE_ARENA (1024*1024)      // in pixels
+#endif
+
+typedef struct {
+    int width;
+    int height;
+    unsigned int capacity;   // Pixels available in pixels[]
+    unsigned int pixels[RAYLIB_JS_FRAMEBUFFER_CAPACITY];
+} RaylibJsFramebuffer;
+
+// Lights the 3D mode with a directional light shining towards direction. The surfaces facing away
+// from it keep ambient, from 0 to 1, of their color. DrawCube(), DrawPlane(), DrawTriangle3D() and
+// the meshes without normals are flat shaded, the meshes with normals are lit at their vertices
+// and Gouraud shaded. The light is off until this is called, like with the default shader of
+// raylib, and a direction of zero turns it off again.
+void SetSoftwareLight(Vector3 direction, float ambient);
+
+//----------------------------------------------------------------------------------
+// Render batch of rlgl (RAYLIB_JS_RLGL)
+//----------------------------------------------------------------------------------
+// A draw is a run of vertices of the same mode (RL_LINES, RL_TRIANGLES or RL_QUADS) and texture
+// (0 for none). Its vertexCount is always a multiple of the vertices of a primitive when
+// raylib.js draws it.
+#if defined(RAYLIB_JS_RLGL) && defined(RAYLIB_JS_SOFTWARE_RENDERER)
+#error "RAYLIB_JS_RLGL and RAYLIB_JS_SOFTWARE_RENDERER can't be enabled together"
+#endif
+
+#define RAYLIB_JS_BATCH_MAX_DRAWS 256       // Keep in sync with raylib.js
+
+#ifndef RAYLIB_JS_BATCH_MAX_VERTICES
+#define RAYLIB_JS_BATCH_MAX_VERTICES (8*1024)
+#endif
+
+typedef struct {
+    float x;
+    float y;
+    float u;                // Texture coordinates, 0 to 1
+    float v;
+    unsigned int color;     // 0xAABBGGRR
+} RaylibJsBatchVertex;
+
+typedef struct {
+    int mode;
+    unsigned int texture;
+    unsigned int vertexStart;
+    unsigned int vertexCount;
+} RaylibJsBatchDraw;
+
+typedef struct {
+    unsigned int vertexCount;
+    unsigned int drawCount;
+    RaylibJsBatchDraw draws[RAYLIB_JS_BATCH_MAX_DRAWS];
+    RaylibJsBatchVertex vertices[RAYLIB_JS_BATCH_MAX_VERTICES];
+} RaylibJsRenderBatch;
+
+RaylibJsRenderBatch *raylib_js_render_batch(void);
+
+// Implemented by raylib.js. Draws the whole batch and empties it.
+void raylib_js_draw_batch(void);
+
+// With RAYLIB_JS_COMMAND_BUFFER the batch is recorded into the command buffer instead of being
+// drawn, so it's drawn in order with the commands and goes through the ring of the blocking mode.
+// Implemented by raylib_js_commands.c and called by raylib.js too, before it executes the commands.
+void raylib_js_record_batch(void);
+
+#if defined(RAYLIB_JS_RLGL) && defined(RAYLIB_JS_COMMAND_BUFFER)
+#if 3 + RAYLIB_JS_BATCH_MAX_DRAWS*4 + RAYLIB_JS_BATCH_MAX_VERTICES*5 > RAYLIB_JS_COMMAND_BUFFER_CAPACITY
+#error "The whole render batch has to fit into the command buffer. Make RAYLIB_JS_COMMAND_BUFFER_CAPACITY bigger or RAYLIB_JS_BATCH_MAX_VERTICES smaller."
+#endif
+#endif
+
+#endif // RAYLIB_JS_H_
@@ -0,0 +1,201 @@
+// The 2D camera and the matrix stack of rlgl for PLATFORM_WEB builds.
+//
+// The matrices are computed here with raymath, and only the 2D affine part of the current one is
+// shared with raylib.js in a RaylibJsTransform. raylib.js applies it with ctx.setTransform() before
+// the next draw after it has changed, so pushing, transforming and popping the matrix doesn't call
+// into JavaScript at all. The drawing functions implemented in wasm skip what falls outside of the
+// screen with raylib_js_visible(), so a world bigger than the screen costs what is visible.
+//
+// Unlike in raylib, the batch of RAYLIB_JS_RLGL doesn't have to be drawn when the camera changes,
+// because its vertices are transformed as they are added. The software renderer draws the 2D
+// shapes without a transform, so none of this is there.
+#ifndef RAYLIB_JS_SOFTWARE_RENDERER
+
+#include <raylib.h>
+#include <rlgl.h>
+#define RAYMATH_STATIC_INLINE
+#include <raymath.h>
+#include "raylib_js.h"
+
+static RaylibJsTransform transform = {
+    .a = 1.0f,
+    .d = 1.0f,
+};
+
+static Matrix current_matrix = {
+    1.0f, 0.0f, 0.0f, 0.0f,
+    0.0f, 1.0f, 0.0f, 0.0f,
+    0.0f, 0.0f, 1.0f, 0.0f,
+    0.0f, 0.0f, 0.0f, 1.0f,
+};
+static Matrix matrix_stack[RAYLIB_JS_MATRIX_STACK_SIZE];
+static int matrix_stack_count = 0;
+
+// The matrix EndMode2D() goes back to
+static Matrix matrix_before_mode_2d;
+static bool in_mode_2d = false;
+
+// The screen mapped back into the coordinates of the current matrix, the bounding box of it if
+// the matrix rotates. Computed again by raylib_js_visible() when the matrix or the screen changes.
+static unsigned int view_version = ~0u;
+static int view_width = -1;
+static int view_height = -1;
+static float view_left, view_top, view_right, view_bottom;
+
+RAYLIB_JS_EXPORT(raylib_js_transform)
+RaylibJsTransform *raylib_js_transform(void)
+{
+    return &transform;
+}
+
+static void set_matrix(Matrix matrix)
+{
+    current_matrix = matrix;
+    transform.a = matrix.m0;
+    transform.b = matrix.m1;
+    transform.c = matrix.m4;
+    transform.d = matrix.m5;
+    transform.e = matrix.m12;
+    transform.f = matrix.m13;
+    transform.version += 1;
+}
+
+static void update_view(void)
+{
+    view_version = transform.version;
+    view_width = transform.screenWidth;
+    view_height = transform.screenHeight;
+
+    float det = transform.a*transform.d - transform.b*transform.c;
+    if (det == 0.0f) {
+        // Everything is squashed into a line or a point
+        view_left = view_top = 1.0f;
+        view_right = view_bottom = -1.0f;
+        return;
+    }
+    float corners[4][2] = {
+        { 0.0f, 0.0f },
+        { view_width, 0.0f },
+        { 0.0f, view_height },
+        { view_width, view_height },
+    };
+    for (int i = 0; i < 4; ++i) {
+        float x = corners[i][0] - transform.e;
+        float y = corners[i][1] - transform.f;
+        float worldX = (transform.d*x - transform.c*y)/det;
+        float worldY = (transform.a*y - transform.b*x)/det;
+        if (i == 0 || worldX < view_left) view_left = worldX;
+        if (i == 0 || worldX > view_right) view_right = worldX;
+        if (i == 0 || worldY < view_top) view_top = worldY;
+        if (i == 0 || worldY > view_bottom) view_bottom = worldY;
+    }
+}
+
+bool raylib_js_visible(Rectangle bounds)
+{
+    if (view_version != transform.version || view_width != transform.screenWidth || view_height != transform.screenHeight) {
+        update_view();
+    }
+    float left = bounds.width < 0 ? bounds.x + bounds.width : bounds.x;
+    float top = bounds.height < 0 ? bounds.y + bounds.height : bounds.y;
+    float right = bounds.width < 0 ? bounds.x : bounds.x + bounds.width;
+    float bottom = bounds.height < 0 ? bounds.y : bounds.y + bounds.height;
+    if (right < view_left || left > view_right || bottom < view_top || top > view_bottom) {
+        transform.culled += 1;
+        return false;
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Matrix stack, same as in rlgl.h of raylib with the modelview as the only matrix
+//----------------------------------------------------------------------------------
+void rlMatrixMode(int mode)
+{
+    (void)mode;
+}
+
+void rlPushMatrix(void)
+{
+    if (matrix_stack_count == RAYLIB_JS_MATRIX_STACK_SIZE) {
+        TraceLog(LOG_ERROR, "RLGL: Matrix stack overflow (RL_MAX_MATRIX_STACK_SIZE)");
+        return;
+    }
+    matrix_stack[matrix_stack_count++] = current_matrix;
+}
+
+void rlPopMatrix(void)
+{
+    if (matrix_stack_count > 0) set_matrix(matrix_stack[--matrix_stack_count]);
+}
+
+void rlLoadIdentity(void)
+{
+    set_matrix(MatrixIdentity());
+}
+
+void rlTranslatef(float x, float y, float z)
+{
+    set_matrix(MatrixMultiply(MatrixTranslate(x, y, z), current_matrix));
+}
+
+void rlRotatef(float angle, float x, float y, float z)
+{
+    set_matrix(MatrixMultiply(MatrixRotate((Vector3){ x, y, z }, angle*DEG2RAD), current_matrix));
+}
+
+void rlScalef(float x, float y, float z)
+{
+    set_matrix(MatrixMultiply(MatrixScale(x, y, z), current_matrix));
+}
+
+void rlMultMatrixf(const float *matf)
+{
+    Matrix matrix = {
+        matf[0], matf[4], matf[8], matf[12],
+        matf[1], matf[5], matf[9], matf[13],
+        matf[2], matf[6], matf[10], matf[14],
+        matf[3], matf[7], matf[11], matf[15],
+    };
+    set_matrix(MatrixMultiply(current_matrix, matrix));
+}
+
+//----------------------------------------------------------------------------------
+// 2D camera, same as in rcore.c of raylib
+//----------------------------------------------------------------------------------
+Matrix GetCameraMatrix2D(Camera2D camera)
+{
+    Matrix matOrigin = MatrixTranslate(-camera.target.x, -camera.target.y, 0.0f);
+    Matrix matRotation = MatrixRotate((Vector3){ 0.0f, 0.0f, 1.0f }, camera.rotation*DEG2RAD);
+    Matrix matScale = MatrixScale(camera.zoom, camera.zoom, 1.0f);
+    Matrix matTranslation = MatrixTranslate(camera.offset.x, camera.offset.y, 0.0f);
+    return MatrixMultiply(MatrixMultiply(matOrigin, MatrixMultiply(matScale, matRotation)), matTranslation);
+}
+
+Vector2 GetWorldToScreen2D(Vector2 position, Camera2D camera)
+{
+    return Vector2Transform(position, GetCameraMatrix2D(camera));
+}
+
+Vector2 GetScreenToWorld2D(Vector2 position, Camera2D camera)
+{
+    return Vector2Transform(position, MatrixInvert(GetCameraMatrix2D(camera)));
+}
+
+// Like in raylib the camera replaces the current matrix. Unlike in raylib, EndMode2D() goes back
+// to the matrix from before BeginMode2D() instead of the identity, so what a game has pushed and
+// transformed around the 2D mode still applies after it.
+void BeginMode2D(Camera2D camera)
+{
+    if (!in_mode_2d) matrix_before_mode_2d = current_matrix;
+    in_mode_2d = true;
+    set_matrix(GetCameraMatrix2D(camera));
+}
+
+void EndMode2D(void)
+{
+    set_matrix(in_mode_2d ? matrix_before_mode_2d : MatrixIdentity());
+    in_mode_2d = false;
+}
+
+#endif // RAYLIB_JS_SOFTWARE_RENDERER
@@ -0,0 +1,276 @@
+// Command buffer backend for PLATFORM_WEB builds compiled with -DRAYLIB_JS_COMMAND_BUFFER.
+//
+// Instead of crossing into JavaScript on every draw call, the drawing functions below append
+// compact commands to a buffer in the linear memory. RaylibJs executes the whole buffer in
+// EndDrawing(), so a frame costs a single boundary crossing no matter how much it draws.
+//
+// The draws are recorded in the coordinates of the current matrix, see raylib_js_camera.c. The
+// matrix is recorded before the first draw after it has changed, and the draws that end up outside
+// of the screen are not recorded at all.
+#ifdef RAYLIB_JS_COMMAND_BUFFER
+
+#include <raylib.h>
+#include "raylib_js.h"
+
+// NOTE: not initialized statically, so it takes no space in the module. raylib.js asks for it
+// before the game starts, which sets the capacity.
+static RaylibJsCommandBuffer command_buffer;
+
+// The version of RaylibJsTransform the recorded draws are in. A layer starts untransformed, so the
+// matrix is recorded again after BeginLayer() and EndLayer().
+static bool transform_recorded = false;
+static unsigned int recorded_transform = 0;
+
+// Whether the layer has been recorded and not marked dirty since
+static bool layer_recorded[RAYLIB_JS_MAX_LAYERS];
+
+RAYLIB_JS_EXPORT(raylib_js_command_buffer)
+RaylibJsCommandBuffer *raylib_js_command_buffer(void)
+{
+    command_buffer.capacity = RAYLIB_JS_COMMAND_BUFFER_CAPACITY;
+    return &command_buffer;
+}
+
+static unsigned int color_pack(Color color)
+{
+    return color.r | (color.g << 8) | (color.b << 16) | ((unsigned int)color.a << 24);
+}
+
+static RaylibJsWord *command_append(RaylibJsCommandOp op, unsigned int size)
+{
+    // The buffer is full mid-frame. Let the host draw what we've got so far and start over.
+    if (command_buffer.count + size > command_buffer.capacity) raylib_js_flush_commands();
+    RaylibJsWord *cmd = &command_buffer.words[command_buffer.count];
+    cmd[0].u = op | (size << 8);
+    command_buffer.count += size;
+    return cmd;
+}
+
+static RaylibJsWord *command_push(RaylibJsCommandOp op, unsigned int size)
+{
+#ifdef RAYLIB_JS_RLGL
+    // The primitives batched so far are drawn under the command
+    if (raylib_js_render_batch()->vertexCount > 0) raylib_js_record_batch();
+#endif
+    return command_append(op, size);
+}
+
+#ifdef RAYLIB_JS_RLGL
+// The vertices are already in the coordinates of the screen, so the batch is recorded without the
+// matrix
+RAYLIB_JS_EXPORT(raylib_js_record_batch)
+void raylib_js_record_batch(void)
+{
+    RaylibJsRenderBatch *batch = raylib_js_render_batch();
+    if (batch->vertexCount > 0) {
+        unsigned int drawWords = batch->drawCount*(sizeof(RaylibJsBatchDraw)/4);
+        unsigned int vertexWords = batch->vertexCount*(sizeof(RaylibJsBatchVertex)/4);
+        RaylibJsWord *cmd = command_append(RAYLIB_JS_CMD_DRAW_BATCH, 3 + drawWords + vertexWords);
+        cmd[1].u = batch->drawCount;
+        cmd[2].u = batch->vertexCount;
+        const RaylibJsWord *draws = (const RaylibJsWord*)batch->draws;
+        const RaylibJsWord *vertices = (const RaylibJsWord*)batch->vertices;
+        for (unsigned int i = 0; i < drawWords; ++i) cmd[3 + i] = draws[i];
+        for (unsigned int i = 0; i < vertexWords; ++i) cmd[3 + drawWords + i] = vertices[i];
+    }
+    batch->vertexCount = 0;
+    batch->drawCount = 0;
+}
+#endif
+
+// Pushes a draw, after the matrix if it has changed since the last draw
+static RaylibJsWord *command_push_draw(RaylibJsCommandOp op, unsigned int size)
+{
+    const RaylibJsTransform *transform = raylib_js_transform();
+    if (!transform_recorded || transform->version != recorded_transform) {
+        RaylibJsWord *cmd = command_push(RAYLIB_JS_CMD_SET_TRANSFORM, 7);
+        cmd[1].f = transform->a;
+        cmd[2].f = transform->b;
+        cmd[3].f = transform->c;
+        cmd[4].f = transform->d;
+        cmd[5].f = transform->e;
+        cmd[6].f = transform->f;
+        transform_recorded = true;
+        recorded_transform = transform->version;
+    }
+    return command_push(op, size);
+}
+
+// Pushes a command that has `args` argument words followed by the text.
+static RaylibJsWord *command_push_text(RaylibJsCommandOp op, unsigned int args, const char *text)
+{
+    // NOTE: the text is truncated if it doesn't fit into a quarter of the buffer
+    unsigned int max_len = RAYLIB_JS_COMMAND_BUFFER_CAPACITY;
+    unsigned int len = 0;
+    while (text[len] != '\0' && len < max_len) len++;
+
+    RaylibJsWord *cmd = command_push_draw(op, 1 + args + (len + 1 + 3)/4);
+    char *dst = (char*)&cmd[1 + args];
+    for (unsigned int i = 0; i < len; ++i) dst[i] = text[i];
+    dst[len] = '\0';
+    return cmd;
+}
+
+void ClearBackground(Color color)
+{
+    RaylibJsWord *cmd = command_push(RAYLIB_JS_CMD_CLEAR_BACKGROUND, 2);
+    cmd[1].u = color_pack(color);
+}
+
+static void push_rectangle(float x, float y, float w, float h, Color color)
+{
+    if (!raylib_js_visible((Rectangle){ x, y, w, h })) return;
+    RaylibJsWord *cmd = command_push_draw(RAYLIB_JS_CMD_DRAW_RECTANGLE, 6);
+    cmd[1].f = x;
+    cmd[2].f = y;
+    cmd[3].f = w;
+    cmd[4].f = h;
+    cmd[5].u = color_pack(color);
+}
+
+void DrawRectangle(int posX, int posY, int width, int height, Color color)
+{
+    push_rectangle(posX, posY, width, height, color);
+}
+
+void DrawRectangleV(Vector2 position, Vector2 size, Color color)
+{
+    push_rectangle(position.x, position.y, size.x, size.y, color);
+}
+
+void DrawRectangleRec(Rectangle rec, Color color)
+{
+    push_rectangle(rec.x, rec.y, rec.width, rec.height, color);
+}
+
+void DrawRectangleLinesEx(Rectangle rec, float lineThick, Color color)
+{
+    if (!raylib_js_visible(rec)) return;
+    RaylibJsWord *cmd = command_push_draw(RAYLIB_JS_CMD_DRAW_RECTANGLE_LINES, 7);
+    cmd[1].f = rec.x;
+    cmd[2].f = rec.y;
+    cmd[3].f = rec.width;
+    cmd[4].f = rec.height;
+    cmd[5].f = lineThick;
+    cmd[6].u = color_pack(color);
+}
+
+void DrawCircleV(Vector2 center, float radius, Color color)
+{
+    if (!raylib_js_visible((Rectangle){ center.x - radius, center.y - radius, 2*radius, 2*radius })) return;
+    RaylibJsWord *cmd = command_push_draw(RAYLIB_JS_CMD_DRAW_CIRCLE, 5);
+    cmd[1].f = center.x;
+    cmd[2].f = center.y;
+    cmd[3].f = radius;
+    cmd[4].u = color_pack(color);
+}
+
+void DrawText(const char *text, int posX, int posY, int fontSize, Color color)
+{
+    RaylibJsWord *cmd = command_push_text(RAYLIB_JS_CMD_DRAW_TEXT, 4, text);
+    cmd[1].i = posX;
+    cmd[2].i = posY;
+    cmd[3].i = fontSize;
+    cmd[4].u = color_pack(color);
+}
+
+void DrawTextEx(Font font, const char *text, Vector2 position, float fontSize, float spacing, Color tint)
+{
+    RaylibJsWord *cmd = command_push_text(RAYLIB_JS_CMD_DRAW_TEXT_EX, 6, text);
+    cmd[1].u = font.texture.id;
+    cmd[2].f = position.x;
+    cmd[3].f = position.y;
+    cmd[4].f = fontSize;
+    cmd[5].f = spacing;
+    cmd[6].u = color_pack(tint);
+}
+
+void DrawTexture(Texture2D texture, int posX, int posY, Color tint)
+{
+    // NOTE: the textures that are still being decoded have a size of 0, so they can't be culled
+    if (texture.width > 0 && !raylib_js_visible((Rectangle){ posX, posY, texture.width, texture.height })) return;
+    RaylibJsWord *cmd = command_push_draw(RAYLIB_JS_CMD_DRAW_TEXTURE, 5);
+    cmd[1].u = texture.id;
+    cmd[2].i = posX;
+    cmd[3].i = posY;
+    cmd[4].u = color_pack(tint);
+}
+
+void DrawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint)
+{
+    // The rotation is around the origin, so it stays within the farthest corner from it
+    Rectangle bounds = { dest.x - origin.x, dest.y - origin.y, dest.width, dest.height };
+    if (rotation != 0.0f) {
+        float dx = __builtin_fmaxf(__builtin_fabsf(origin.x), __builtin_fabsf(dest.width - origin.x));
+        float dy = __builtin_fmaxf(__builtin_fabsf(origin.y), __builtin_fabsf(dest.height - origin.y));
+        float radius = dx + dy;
+        bounds = (Rectangle){ dest.x - radius, dest.y - radius, 2*radius, 2*radius };
+    }
+    if (!raylib_js_visible(bounds)) return;
+    RaylibJsWord *cmd = command_push_draw(RAYLIB_JS_CMD_DRAW_TEXTURE_PRO, 14);
+    cmd[1].u = texture.id;
+    cmd[2].f = source.x;
+    cmd[3].f = source.y;
+    cmd[4].f = source.width;
+    cmd[5].f = source.height;
+    cmd[6].f = dest.x;
+    cmd[7].f = dest.y;
+    cmd[8].f = dest.width;
+    cmd[9].f = dest.height;
+    cmd[10].f = origin.x;
+    cmd[11].f = origin.y;
+    cmd[12].f = rotation;
+    cmd[13].u = color_pack(tint);
+}
+
+// NOTE: TraceLog() of raylib.js doesn't format, so the message names the function instead of the id
+static bool layer_id_valid(int id, const char *message)
+{
+    if (id >= 0 && id < RAYLIB_JS_MAX_LAYERS) return true;
+    TraceLog(LOG_WARNING, message);
+    return false;
+}
+
+bool BeginLayer(int id)
+{
+    if (!layer_id_valid(id, "LAYER: BeginLayer() got an id out of [0, RAYLIB_JS_MAX_LAYERS)")) return false;
+    if (layer_recorded[id]) return false;
+    layer_recorded[id] = true;
+    RaylibJsWord *cmd = command_push(RAYLIB_JS_CMD_BEGIN_LAYER, 2);
+    cmd[1].i = id;
+    transform_recorded = false;
+    return true;
+}
+
+void EndLayer(void)
+{
+    command_push(RAYLIB_JS_CMD_END_LAYER, 1);
+    transform_recorded = false;
+}
+
+void DrawLayer(int id, int posX, int posY)
+{
+    if (!layer_id_valid(id, "LAYER: DrawLayer() got an id out of [0, RAYLIB_JS_MAX_LAYERS)")) return;
+    const RaylibJsTransform *transform = raylib_js_transform();
+    if (!raylib_js_visible((Rectangle){ posX, posY, transform->screenWidth, transform->screenHeight })) return;
+    RaylibJsWord *cmd = command_push_draw(RAYLIB_JS_CMD_DRAW_LAYER, 4);
+    cmd[1].i = id;
+    cmd[2].i = posX;
+    cmd[3].i = posY;
+}
+
+void MarkLayerDirty(int id)
+{
+    if (!layer_id_valid(id, "LAYER: MarkLayerDirty() got an id out of [0, RAYLIB_JS_MAX_LAYERS)")) return;
+    layer_recorded[id] = false;
+}
+
+void UnloadLayer(int id)
+{
+    if (!layer_id_valid(id, "LAYER: UnloadLayer() got an id out of [0, RAYLIB_JS_MAX_LAYERS)")) return;
+    layer_recorded[id] = false;
+    RaylibJsWord *cmd = command_push(RAYLIB_JS_CMD_UNLOAD_LAYER, 2);
+    cmd[1].i = id;
+}
+
+#endif // RAYLIB_JS_COMMAND_BUFFER
@@ -0,0 +1,84 @@
+// The default font of raylib for PLATFORM_WEB builds compiled with -DRAYLIB_JS_DEFAULT_FONT.
+//
+// nob.c bakes the bitmap and the glyph rectangles of the font that is built into raylib into
+// raylib_js_default_font_data.h, so they end up in the data section of the module. MeasureText()
+// becomes a loop over the glyph table that never leaves wasm, and raylib.js uploads the atlas
+// once at startup and draws DrawText() by blitting from it. This replaces the web font and the
+// #FONT_SCALE_MAGIC approximation with the exact metrics of raylib.
+#ifdef RAYLIB_JS_DEFAULT_FONT
+
+#include <raylib.h>
+#include "raylib_js.h"
+#include "raylib_js_default_font_data.h"
+
+RAYLIB_JS_EXPORT(raylib_js_default_font)
+const RaylibJsDefaultFont *raylib_js_default_font(void)
+{
+    return &raylib_js_default_font_data;
+}
+
+int raylib_js_next_codepoint(const unsigned char **text)
+{
+    const unsigned char *s = *text;
+    int codepoint = '?';
+    int size = 1;
+    if (s[0] < 0x80) {
+        codepoint = s[0];
+    } else if ((s[0] & 0xE0) == 0xC0 && (s[1] & 0xC0) == 0x80) {
+        codepoint = ((s[0] & 0x1F) << 6) | (s[1] & 0x3F);
+        size = 2;
+    } else if ((s[0] & 0xF0) == 0xE0 && (s[1] & 0xC0) == 0x80 && (s[2] & 0xC0) == 0x80) {
+        codepoint = ((s[0] & 0x0F) << 12) | ((s[1] & 0x3F) << 6) | (s[2] & 0x3F);
+        size = 3;
+    } else if ((s[0] & 0xF8) == 0xF0 && (s[1] & 0xC0) == 0x80 && (s[2] & 0xC0) == 0x80 && (s[3] & 0xC0) == 0x80) {
+        codepoint = ((s[0] & 0x07) << 18) | ((s[1] & 0x3F) << 12) | ((s[2] & 0x3F) << 6) | (s[3] & 0x3F);
+        size = 4;
+    }
+    *text += size;
+    return codepoint;
+}
+
+static int glyph_index(int codepoint)
+{
+    int index = codepoint - ' ';
+    if (index < 0 || index >= RAYLIB_JS_DEFAULT_FONT_GLYPH_COUNT) index = '?' - ' ';
+    return index;
+}
+
+// Same as MeasureTextEx() of raylib for the default font
+static Vector2 measure_default_font(const char *text, float fontSize, float spacing)
+{
+    Vector2 textSize = { 0.0f, fontSize };
+    float textWidth = 0.0f;
+    float maxTextWidth = 0.0f;
+    int lineLength = 0;
+    int maxLineLength = 0;
+
+    const unsigned char *s = (const unsigned char *)text;
+    while (*s != '\0') {
+        int codepoint = raylib_js_next_codepoint(&s);
+        if (codepoint != '\n') {
+            textWidth += raylib_js_default_font_data.recs[glyph_index(codepoint)].width;
+            lineLength += 1;
+        } else {
+            if (maxTextWidth < textWidth) maxTextWidth = textWidth;
+            textWidth = 0.0f;
+            lineLength = 0;
+            textSize.y += fontSize + RAYLIB_JS_DEFAULT_FONT_LINE_SPACING;
+        }
+        if (maxLineLength < lineLength) maxLineLength = lineLength;
+    }
+    if (maxTextWidth < textWidth) maxTextWidth = textWidth;
+
+    textSize.x = maxTextWidth*(fontSize/RAYLIB_JS_DEFAULT_FONT_BASE_SIZE) + (maxLineLength - 1)*spacing;
+    return textSize;
+}
+
+int MeasureText(const char *text, int fontSize)
+{
+    if (fontSize < RAYLIB_JS_DEFAULT_FONT_BASE_SIZE) fontSize = RAYLIB_JS_DEFAULT_FONT_BASE_SIZE;
+    int spacing = fontSize/RAYLIB_JS_DEFAULT_FONT_BASE_SIZE;
+    return (int)measure_default_font(text, fontSize, spacing).x;
+}
+
+#endif // RAYLIB_JS_DEFAULT_FONT
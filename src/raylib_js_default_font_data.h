@@ -0,0 +1,299 @@
+// Generated by nob.c from /tmp/rv/rtext.c. DO NOT EDIT!
+static const RaylibJsDefaultFont raylib_js_default_font_data = {
+    .baseSize = 10,
+    .glyphCount = 224,
+    .atlasWidth = 128,
+    .atlasHeight = 128,
+    .atlas = {
+        0x00000000, 0x9e3779b1, 0x3c6ef362, 0xdaa66d13, 0x78dde6c4, 0x17156075, 0xb54cda26, 0x538453d7,
+        0xf1bbcd88, 0x8ff34739, 0x2e2ac0ea, 0xcc623a9b, 0x6a99b44c, 0x08d12dfd, 0xa708a7ae, 0x4540215f,
+        0xe3779b10, 0x81af14c1, 0x1fe68e72, 0xbe1e0823, 0x5c5581d4, 0xfa8cfb85, 0x98c47536, 0x36fbeee7,
+        0xd5336898, 0x736ae249, 0x11a25bfa, 0xafd9d5ab, 0x4e114f5c, 0xec48c90d, 0x8a8042be, 0x28b7bc6f,
+        0xc6ef3620, 0x6526afd1, 0x035e2982, 0xa195a333, 0x3fcd1ce4, 0xde049695, 0x7c3c1046, 0x1a7389f7,
+        0xb8ab03a8, 0x56e27d59, 0xf519f70a, 0x935170bb, 0x3188ea6c, 0xcfc0641d, 0x6df7ddce, 0x0c2f577f,
+        0xaa66d130, 0x489e4ae1, 0xe6d5c492, 0x850d3e43, 0x2344b7f4, 0xc17c31a5, 0x5fb3ab56, 0xfdeb2507,
+        0x9c229eb8, 0x3a5a1869, 0xd891921a, 0x76c90bcb, 0x1500857c, 0xb337ff2d, 0x516f78de, 0xefa6f28f,
+        0x8dde6c40, 0x2c15e5f1, 0xca4d5fa2, 0x6884d953, 0x06bc5304, 0xa4f3ccb5, 0x432b4666, 0xe162c017,
+        0x7f9a39c8, 0x1dd1b379, 0xbc092d2a, 0x5a40a6db, 0xf878208c, 0x96af9a3d, 0x34e713ee, 0xd31e8d9f,
+        0x71560750, 0x0f8d8101, 0xadc4fab2, 0x4bfc7463, 0xea33ee14, 0x886b67c5, 0x26a2e176, 0xc4da5b27,
+        0x6311d4d8, 0x01494e89, 0x9f80c83a, 0x3db841eb, 0xdbefbb9c, 0x7a27354d, 0x185eaefe, 0xb69628af,
+        0x54cda260, 0xf3051c11, 0x913c95c2, 0x2f740f73, 0xcdab8924, 0x6be302d5, 0x0a1a7c86, 0xa851f637,
+        0x46896fe8, 0xe4c0e999, 0x82f8634a, 0x212fdcfb, 0xbf6756ac, 0x5d9ed05d, 0xfbd64a0e, 0x9a0dc3bf,
+        0x38453d70, 0xd67cb721, 0x74b430d2, 0x12ebaa83, 0xb1232434, 0x4f5a9de5, 0xed921796, 0x8bc99147,
+        0x2a010af8, 0xc83884a9, 0x666ffe5a, 0x04a7780b, 0xa2def1bc, 0x41166b6d, 0xdf4de51e, 0x7d855ecf,
+        0x1bbcd880, 0xb9f45231, 0x582bcbe2, 0xf6634593, 0x949abf44, 0x32d238f5, 0xd109b2a6, 0x6f412c57,
+        0x0d78a608, 0xabb01fb9, 0x49e7996a, 0xe81f131b, 0x86568ccc, 0x248e067d, 0xc2c5802e, 0x60fcf9df,
+        0xff347390, 0x9d6bed41, 0x3ba366f2, 0xd9dae0a3, 0x78125a54, 0x1649d405, 0xb4814db6, 0x52b8c767,
+        0xf0f04118, 0x8f27bac9, 0x2d5f347a, 0xcb96ae2b, 0x69ce27dc, 0x0805a18d, 0xa63d1b3e, 0x447494ef,
+        0xe2ac0ea0, 0x80e38851, 0x1f1b0202, 0xbd527bb3, 0x5b89f564, 0xf9c16f15, 0x97f8e8c6, 0x36306277,
+        0xd467dc28, 0x729f55d9, 0x10d6cf8a, 0xaf0e493b, 0x4d45c2ec, 0xeb7d3c9d, 0x89b4b64e, 0x27ec2fff,
+        0xc623a9b0, 0x645b2361, 0x02929d12, 0xa0ca16c3, 0x3f019074, 0xdd390a25, 0x7b7083d6, 0x19a7fd87,
+        0xb7df7738, 0x5616f0e9, 0xf44e6a9a, 0x9285e44b, 0x30bd5dfc, 0xcef4d7ad, 0x6d2c515e, 0x0b63cb0f,
+        0xa99b44c0, 0x47d2be71, 0xe60a3822, 0x8441b1d3, 0x22792b84, 0xc0b0a535, 0x5ee81ee6, 0xfd1f9897,
+        0x9b571248, 0x398e8bf9, 0xd7c605aa, 0x75fd7f5b, 0x1434f90c, 0xb26c72bd, 0x50a3ec6e, 0xeedb661f,
+        0x8d12dfd0, 0x2b4a5981, 0xc981d332, 0x67b94ce3, 0x05f0c694, 0xa4284045, 0x425fb9f6, 0xe09733a7,
+        0x7ecead58, 0x1d062709, 0xbb3da0ba, 0x59751a6b, 0xf7ac941c, 0x95e40dcd, 0x341b877e, 0xd253012f,
+        0x708a7ae0, 0x0ec1f491, 0xacf96e42, 0x4b30e7f3, 0xe96861a4, 0x879fdb55, 0x25d75506, 0xc40eceb7,
+        0x62464868, 0x007dc219, 0x9eb53bca, 0x3cecb57b, 0xdb242f2c, 0x795ba8dd, 0x1793228e, 0xb5ca9c3f,
+        0x540215f0, 0xf2398fa1, 0x90710952, 0x2ea88303, 0xccdffcb4, 0x6b177665, 0x094ef016, 0xa78669c7,
+        0x45bde378, 0xe3f55d29, 0x822cd6da, 0x2064508b, 0xbe9bca3c, 0x5cd343ed, 0xfb0abd9e, 0x9942374f,
+        0x3779b100, 0xd5b12ab1, 0x73e8a462, 0x12201e13, 0xb05797c4, 0x4e8f1175, 0xecc68b26, 0x8afe04d7,
+        0x29357e88, 0xc76cf839, 0x65a471ea, 0x03dbeb9b, 0xa213654c, 0x404adefd, 0xde8258ae, 0x7cb9d25f,
+        0x1af14c10, 0xb928c5c1, 0x57603f72, 0xf597b923, 0x93cf32d4, 0x3206ac85, 0xd03e2636, 0x6e759fe7,
+        0x0cad1998, 0xaae49349, 0x491c0cfa, 0xe75386ab, 0x858b005c, 0x23c27a0d, 0xc1f9f3be, 0x60316d6f,
+        0xfe68e720, 0x9ca060d1, 0x3ad7da82, 0xd90f5433, 0x7746cde4, 0x157e4795, 0xb3b5c146, 0x51ed3af7,
+        0xf024b4a8, 0x8e5c2e59, 0x2c93a80a, 0xcacb21bb, 0x69029b6c, 0x073a151d, 0xa5718ece, 0x43a9087f,
+        0xe1e08230, 0x8017fbe1, 0x1e4f7592, 0xbc86ef43, 0x5abe68f4, 0xf8f5e2a5, 0x972d5c56, 0x3564d607,
+        0xd39c4fb8, 0x71d3c969, 0x100b431a, 0xae42bccb, 0x4c7a367c, 0xeab1b02d, 0x88e929de, 0x2720a38f,
+        0xc5581d40, 0x638f96f1, 0x01c710a2, 0x9ffe8a53, 0x3e360404, 0xdc6d7db5, 0x7aa4f766, 0x18dc7117,
+        0xb713eac8, 0x554b6479, 0xf382de2a, 0x91ba57db, 0x2ff1d18c, 0xce294b3d, 0x6c60c4ee, 0x0a983e9f,
+        0xa8cfb850, 0x47073201, 0xe53eabb2, 0x83762563, 0x21ad9f14, 0xbfe518c5, 0x5e1c9276, 0xfc540c27,
+        0x9a8b85d8, 0x38c2ff89, 0xd6fa793a, 0x7531f2eb, 0x13696c9c, 0xb1a0e64d, 0x4fd85ffe, 0xee0fd9af,
+        0x8c475360, 0x2a7ecd11, 0xc8b646c2, 0x66edc073, 0x05253a24, 0xa35cb3d5, 0x41942d86, 0xdfcba737,
+        0x7e0320e8, 0x1c3a9a99, 0xba72144a, 0x58a98dfb, 0xf6e107ac, 0x9518815d, 0x334ffb0e, 0xd18774bf,
+        0x6fbeee70, 0x0df66821, 0xac2de1d2, 0x4a655b83, 0xe89cd534, 0x86d44ee5, 0x250bc896, 0xc3434247,
+        0x617abbf8, 0xffb235a9, 0x9de9af5a, 0x3c21290b, 0xda58a2bc, 0x78901c6d, 0x16c7961e, 0xb4ff0fcf,
+        0x53368980, 0xf16e0331, 0x8fa57ce2, 0x2ddcf693, 0xcc147044, 0x6a4be9f5, 0x088363a6, 0xa6badd57,
+        0x44f25708, 0xe329d0b9, 0x81614a6a, 0x1f98c41b, 0xbdd03dcc, 0x5c07b77d, 0xfa3f312e, 0x9876aadf,
+        0x36ae2490, 0xd4e59e41, 0x731d17f2, 0x115491a3, 0xaf8c0b54, 0x4dc38505, 0xebfafeb6, 0x8a327867,
+        0x2869f218, 0xc6a16bc9, 0x64d8e57a, 0x03105f2b, 0xa147d8dc, 0x3f7f528d, 0xddb6cc3e, 0x7bee45ef,
+        0x1a25bfa0, 0xb85d3951, 0x5694b302, 0xf4cc2cb3, 0x9303a664, 0x313b2015, 0xcf7299c6, 0x6daa1377,
+        0x0be18d28, 0xaa1906d9, 0x4850808a, 0xe687fa3b, 0x84bf73ec, 0x22f6ed9d, 0xc12e674e, 0x5f65e0ff,
+        0xfd9d5ab0, 0x9bd4d461, 0x3a0c4e12, 0xd843c7c3, 0x767b4174, 0x14b2bb25, 0xb2ea34d6, 0x5121ae87,
+        0xef592838, 0x8d90a1e9, 0x2bc81b9a, 0xc9ff954b, 0x68370efc, 0x066e88ad, 0xa4a6025e, 0x42dd7c0f,
+        0xe114f5c0, 0x7f4c6f71, 0x1d83e922, 0xbbbb62d3, 0x59f2dc84, 0xf82a5635, 0x9661cfe6, 0x34994997,
+        0xd2d0c348, 0x71083cf9, 0x0f3fb6aa, 0xad77305b, 0x4baeaa0c, 0xe9e623bd, 0x881d9d6e, 0x2655171f,
+        0xc48c90d0, 0x62c40a81, 0x00fb8432, 0x9f32fde3, 0x3d6a7794, 0xdba1f145, 0x79d96af6, 0x1810e4a7,
+        0xb6485e58, 0x547fd809, 0xf2b751ba, 0x90eecb6b, 0x2f26451c, 0xcd5dbecd, 0x6b95387e, 0x09ccb22f,
+        0xa8042be0, 0x463ba591, 0xe4731f42, 0x82aa98f3, 0x20e212a4, 0xbf198c55, 0x5d510606, 0xfb887fb7,
+        0x99bff968, 0x37f77319, 0xd62eecca, 0x7466667b, 0x129de02c, 0xb0d559dd, 0x4f0cd38e, 0xed444d3f,
+        0x8b7bc6f0, 0x29b340a1, 0xc7eaba52, 0x66223403, 0x0459adb4, 0xa2912765, 0x40c8a116, 0xdf001ac7,
+        0x7d379478, 0x1b6f0e29, 0xb9a687da, 0x57de018b, 0xf6157b3c, 0x944cf4ed, 0x32846e9e, 0xd0bbe84f,
+    },
+    .recs = {
+        { 1, 1, 3, 10 },
+        { 5, 1, 1, 10 },
+        { 7, 1, 4, 10 },
+        { 12, 1, 6, 10 },
+        { 19, 1, 5, 10 },
+        { 25, 1, 7, 10 },
+        { 33, 1, 6, 10 },
+        { 40, 1, 2, 10 },
+        { 43, 1, 3, 10 },
+        { 47, 1, 3, 10 },
+        { 51, 1, 5, 10 },
+        { 57, 1, 5, 10 },
+        { 63, 1, 2, 10 },
+        { 66, 1, 4, 10 },
+        { 71, 1, 1, 10 },
+        { 73, 1, 7, 10 },
+        { 81, 1, 5, 10 },
+        { 87, 1, 2, 10 },
+        { 90, 1, 5, 10 },
+        { 96, 1, 5, 10 },
+        { 102, 1, 5, 10 },
+        { 108, 1, 5, 10 },
+        { 114, 1, 5, 10 },
+        { 120, 1, 5, 10 },
+        { 1, 12, 5, 10 },
+        { 7, 12, 5, 10 },
+        { 13, 12, 1, 10 },
+        { 15, 12, 1, 10 },
+        { 17, 12, 3, 10 },
+        { 21, 12, 4, 10 },
+        { 26, 12, 3, 10 },
+        { 30, 12, 6, 10 },
+        { 37, 12, 7, 10 },
+        { 45, 12, 6, 10 },
+        { 52, 12, 6, 10 },
+        { 59, 12, 6, 10 },
+        { 66, 12, 6, 10 },
+        { 73, 12, 6, 10 },
+        { 80, 12, 6, 10 },
+        { 87, 12, 6, 10 },
+        { 94, 12, 6, 10 },
+        { 101, 12, 3, 10 },
+        { 105, 12, 5, 10 },
+        { 111, 12, 6, 10 },
+        { 118, 12, 5, 10 },
+        { 1, 23, 7, 10 },
+        { 9, 23, 6, 10 },
+        { 16, 23, 6, 10 },
+        { 23, 23, 6, 10 },
+        { 30, 23, 6, 10 },
+        { 37, 23, 6, 10 },
+        { 44, 23, 6, 10 },
+        { 51, 23, 7, 10 },
+        { 59, 23, 6, 10 },
+        { 66, 23, 7, 10 },
+        { 74, 23, 7, 10 },
+        { 82, 23, 6, 10 },
+        { 89, 23, 6, 10 },
+        { 96, 23, 6, 10 },
+        { 103, 23, 2, 10 },
+        { 106, 23, 7, 10 },
+        { 114, 23, 2, 10 },
+        { 117, 23, 3, 10 },
+        { 121, 23, 5, 10 },
+        { 1, 34, 2, 10 },
+        { 4, 34, 5, 10 },
+        { 10, 34, 5, 10 },
+        { 16, 34, 5, 10 },
+        { 22, 34, 5, 10 },
+        { 28, 34, 5, 10 },
+        { 34, 34, 4, 10 },
+        { 39, 34, 5, 10 },
+        { 45, 34, 5, 10 },
+        { 51, 34, 1, 10 },
+        { 53, 34, 2, 10 },
+        { 56, 34, 5, 10 },
+        { 62, 34, 2, 10 },
+        { 65, 34, 5, 10 },
+        { 71, 34, 5, 10 },
+        { 77, 34, 5, 10 },
+        { 83, 34, 5, 10 },
+        { 89, 34, 5, 10 },
+        { 95, 34, 5, 10 },
+        { 101, 34, 5, 10 },
+        { 107, 34, 4, 10 },
+        { 112, 34, 5, 10 },
+        { 118, 34, 5, 10 },
+        { 1, 45, 5, 10 },
+        { 7, 45, 5, 10 },
+        { 13, 45, 5, 10 },
+        { 19, 45, 5, 10 },
+        { 25, 45, 3, 10 },
+        { 29, 45, 1, 10 },
+        { 31, 45, 3, 10 },
+        { 35, 45, 4, 10 },
+        { 40, 45, 4, 10 },
+        { 45, 45, 1, 10 },
+        { 47, 45, 1, 10 },
+        { 49, 45, 1, 10 },
+        { 51, 45, 1, 10 },
+        { 53, 45, 1, 10 },
+        { 55, 45, 1, 10 },
+        { 57, 45, 1, 10 },
+        { 59, 45, 1, 10 },
+        { 61, 45, 1, 10 },
+        { 63, 45, 1, 10 },
+        { 65, 45, 1, 10 },
+        { 67, 45, 1, 10 },
+        { 69, 45, 1, 10 },
+        { 71, 45, 1, 10 },
+        { 73, 45, 1, 10 },
+        { 75, 45, 1, 10 },
+        { 77, 45, 1, 10 },
+        { 79, 45, 1, 10 },
+        { 81, 45, 1, 10 },
+        { 83, 45, 1, 10 },
+        { 85, 45, 1, 10 },
+        { 87, 45, 1, 10 },
+        { 89, 45, 1, 10 },
+        { 91, 45, 1, 10 },
+        { 93, 45, 1, 10 },
+        { 95, 45, 1, 10 },
+        { 97, 45, 1, 10 },
+        { 99, 45, 1, 10 },
+        { 101, 45, 1, 10 },
+        { 103, 45, 1, 10 },
+        { 105, 45, 1, 10 },
+        { 107, 45, 1, 10 },
+        { 109, 45, 1, 10 },
+        { 111, 45, 1, 10 },
+        { 113, 45, 5, 10 },
+        { 119, 45, 5, 10 },
+        { 1, 56, 5, 10 },
+        { 7, 56, 7, 10 },
+        { 15, 56, 1, 10 },
+        { 17, 56, 5, 10 },
+        { 23, 56, 3, 10 },
+        { 27, 56, 7, 10 },
+        { 35, 56, 3, 10 },
+        { 39, 56, 5, 10 },
+        { 45, 56, 4, 10 },
+        { 50, 56, 1, 10 },
+        { 52, 56, 7, 10 },
+        { 60, 56, 4, 10 },
+        { 65, 56, 3, 10 },
+        { 69, 56, 5, 10 },
+        { 75, 56, 3, 10 },
+        { 79, 56, 3, 10 },
+        { 83, 56, 2, 10 },
+        { 86, 56, 5, 10 },
+        { 92, 56, 6, 10 },
+        { 99, 56, 1, 10 },
+        { 101, 56, 2, 10 },
+        { 104, 56, 2, 10 },
+        { 107, 56, 3, 10 },
+        { 111, 56, 5, 10 },
+        { 117, 56, 6, 10 },
+        { 1, 67, 6, 10 },
+        { 8, 67, 6, 10 },
+        { 15, 67, 6, 10 },
+        { 22, 67, 6, 10 },
+        { 29, 67, 6, 10 },
+        { 36, 67, 6, 10 },
+        { 43, 67, 6, 10 },
+        { 50, 67, 6, 10 },
+        { 57, 67, 6, 10 },
+        { 64, 67, 7, 10 },
+        { 72, 67, 6, 10 },
+        { 79, 67, 6, 10 },
+        { 86, 67, 6, 10 },
+        { 93, 67, 6, 10 },
+        { 100, 67, 6, 10 },
+        { 107, 67, 3, 10 },
+        { 111, 67, 3, 10 },
+        { 115, 67, 3, 10 },
+        { 119, 67, 3, 10 },
+        { 1, 78, 7, 10 },
+        { 9, 78, 6, 10 },
+        { 16, 78, 6, 10 },
+        { 23, 78, 6, 10 },
+        { 30, 78, 6, 10 },
+        { 37, 78, 6, 10 },
+        { 44, 78, 6, 10 },
+        { 51, 78, 5, 10 },
+        { 57, 78, 6, 10 },
+        { 64, 78, 6, 10 },
+        { 71, 78, 6, 10 },
+        { 78, 78, 6, 10 },
+        { 85, 78, 6, 10 },
+        { 92, 78, 6, 10 },
+        { 99, 78, 4, 10 },
+        { 104, 78, 6, 10 },
+        { 111, 78, 5, 10 },
+        { 117, 78, 5, 10 },
+        { 1, 89, 5, 10 },
+        { 7, 89, 5, 10 },
+        { 13, 89, 5, 10 },
+        { 19, 89, 5, 10 },
+        { 25, 89, 9, 10 },
+        { 35, 89, 5, 10 },
+        { 41, 89, 5, 10 },
+        { 47, 89, 5, 10 },
+        { 53, 89, 5, 10 },
+        { 59, 89, 5, 10 },
+        { 65, 89, 2, 10 },
+        { 68, 89, 2, 10 },
+        { 71, 89, 3, 10 },
+        { 75, 89, 3, 10 },
+        { 79, 89, 5, 10 },
+        { 85, 89, 5, 10 },
+        { 91, 89, 5, 10 },
+        { 97, 89, 5, 10 },
+        { 103, 89, 5, 10 },
+        { 109, 89, 5, 10 },
+        { 115, 89, 5, 10 },
+        { 121, 89, 5, 10 },
+        { 1, 100, 5, 10 },
+        { 7, 100, 5, 10 },
+        { 13, 100, 5, 10 },
+        { 19, 100, 5, 10 },
+        { 25, 100, 5, 10 },
+        { 31, 100, 5, 10 },
+        { 37, 100, 5, 10 },
+        { 43, 100, 5, 10 },
+    },
+};
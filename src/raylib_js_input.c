@@ -0,0 +1,12 @@
+// Input state of PLATFORM_WEB builds. raylib.js writes into it directly and the input
+// functions in raylib.h read it, so polling the input doesn't call into JavaScript.
+#include <raylib.h>
+#include "raylib_js.h"
+
+RaylibJsInput raylib_js_input = {0};
+
+RAYLIB_JS_EXPORT(raylib_js_input_state)
+RaylibJsInput *raylib_js_input_state(void)
+{
+    return &raylib_js_input;
+}
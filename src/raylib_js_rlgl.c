@@ -0,0 +1,344 @@
+// rlgl immediate mode for PLATFORM_WEB builds compiled with -DRAYLIB_JS_RLGL.
+//
+// rlBegin()/rlVertex2f()/rlColor4ub()/rlEnd() append vertices to a render batch in the linear
+// memory like rlgl of raylib does, and the primitives of the same mode and texture that follow
+// each other are merged into one draw. raylib.js draws the whole batch in raylib_js_draw_batch(),
+// which is called once at EndDrawing(), or earlier when the batch is full or when something that
+// is not batched is drawn over it. With RAYLIB_JS_COMMAND_BUFFER the batch is recorded into the
+// command buffer at those points instead, so the shapes and the commands can be mixed freely and
+// are still drawn in order with a single flush. The shapes below are ported from rshapes.c of
+// raylib on top of it, so a frame of them costs a single boundary crossing.
+//
+// The vertices are transformed by the current matrix of raylib_js_camera.c as they are added, like
+// rlgl does with the matrices pushed by rlPushMatrix(), so the batch is in the coordinates of the
+// screen. The shapes that end up outside of the screen are not added at all.
+#ifdef RAYLIB_JS_RLGL
+
+#include <raylib.h>
+#include <rlgl.h>
+#include <math.h>
+#include "raylib_js.h"
+
+// NOTE: not initialized statically, so it takes no space in the module
+static RaylibJsRenderBatch render_batch;
+
+static int current_mode = -1;               // -1 outside of rlBegin()/rlEnd()
+static unsigned int current_texture = 0;
+static float current_u = 0.0f;
+static float current_v = 0.0f;
+static unsigned int current_color = 0xFFFFFFFF;
+
+RAYLIB_JS_EXPORT(raylib_js_render_batch)
+RaylibJsRenderBatch *raylib_js_render_batch(void)
+{
+    return &render_batch;
+}
+
+// Hands the batch over to raylib.js and empties it
+static void submit_batch(void)
+{
+#ifdef RAYLIB_JS_COMMAND_BUFFER
+    raylib_js_record_batch();
+#else
+    raylib_js_draw_batch();
+#endif
+}
+
+static int primitive_size(int mode)
+{
+    switch (mode) {
+        case RL_LINES: return 2;
+        case RL_TRIANGLES: return 3;
+        case RL_QUADS: return 4;
+        default: return 1;
+    }
+}
+
+// The draw the next vertex goes to. A new one is started when the mode or the texture changes.
+static RaylibJsBatchDraw *current_draw(void)
+{
+    if (render_batch.drawCount > 0) {
+        RaylibJsBatchDraw *draw = &render_batch.draws[render_batch.drawCount - 1];
+        if (draw->mode == current_mode && draw->texture == current_texture) return draw;
+        // NOTE: a primitive can't span two draws, so what's left of the unfinished one is dropped
+        unsigned int partial = draw->vertexCount%primitive_size(draw->mode);
+        draw->vertexCount -= partial;
+        render_batch.vertexCount -= partial;
+    }
+    if (render_batch.drawCount == RAYLIB_JS_BATCH_MAX_DRAWS) submit_batch();
+    RaylibJsBatchDraw *draw = &render_batch.draws[render_batch.drawCount++];
+    draw->mode = current_mode;
+    draw->texture = current_texture;
+    draw->vertexStart = render_batch.vertexCount;
+    draw->vertexCount = 0;
+    return draw;
+}
+
+// The batch is full mid-primitive. Draw the primitives that are complete and start the next batch
+// with the vertices of the unfinished one.
+static void restart_batch(void)
+{
+    RaylibJsBatchDraw *draw = current_draw();
+    unsigned int partial = draw->vertexCount%primitive_size(draw->mode);
+    RaylibJsBatchVertex carried[4];
+    for (unsigned int i = 0; i < partial; ++i) carried[i] = render_batch.vertices[render_batch.vertexCount - partial + i];
+    draw->vertexCount -= partial;
+    render_batch.vertexCount -= partial;
+    submit_batch();
+
+    draw = current_draw();
+    for (unsigned int i = 0; i < partial; ++i) render_batch.vertices[i] = carried[i];
+    draw->vertexCount = partial;
+    render_batch.vertexCount = partial;
+}
+
+void rlBegin(int mode)
+{
+    current_mode = mode;
+}
+
+void rlEnd(void)
+{
+    if (render_batch.drawCount > 0) {
+        // Drop the unfinished primitive, so the next rlBegin() of the same mode can continue the draw
+        RaylibJsBatchDraw *draw = &render_batch.draws[render_batch.drawCount - 1];
+        unsigned int partial = draw->vertexCount%primitive_size(draw->mode);
+        draw->vertexCount -= partial;
+        render_batch.vertexCount -= partial;
+    }
+    current_mode = -1;
+}
+
+void rlVertex2f(float x, float y)
+{
+    if (current_mode < 0) return;
+    if (render_batch.vertexCount == RAYLIB_JS_BATCH_MAX_VERTICES) restart_batch();
+    RaylibJsBatchDraw *draw = current_draw();
+    const RaylibJsTransform *transform = raylib_js_transform();
+    RaylibJsBatchVertex *vertex = &render_batch.vertices[render_batch.vertexCount++];
+    vertex->x = transform->a*x + transform->c*y + transform->e;
+    vertex->y = transform->b*x + transform->d*y + transform->f;
+    vertex->u = current_u;
+    vertex->v = current_v;
+    vertex->color = current_color;
+    draw->vertexCount += 1;
+}
+
+void rlVertex2i(int x, int y)
+{
+    rlVertex2f(x, y);
+}
+
+// NOTE: the canvas is 2D, z is ignored
+void rlVertex3f(float x, float y, float z)
+{
+    (void)z;
+    rlVertex2f(x, y);
+}
+
+void rlTexCoord2f(float x, float y)
+{
+    current_u = x;
+    current_v = y;
+}
+
+void rlNormal3f(float x, float y, float z)
+{
+    (void)x;
+    (void)y;
+    (void)z;
+}
+
+void rlColor4ub(unsigned char r, unsigned char g, unsigned char b, unsigned char a)
+{
+    current_color = r | (g << 8) | (b << 16) | ((unsigned int)a << 24);
+}
+
+void rlColor4f(float x, float y, float z, float w)
+{
+    rlColor4ub(x*255, y*255, z*255, w*255);
+}
+
+void rlColor3f(float x, float y, float z)
+{
+    rlColor4f(x, y, z, 1.0f);
+}
+
+void rlSetTexture(unsigned int id)
+{
+    current_texture = id;
+}
+
+void rlDrawRenderBatchActive(void)
+{
+    if (render_batch.vertexCount > 0) submit_batch();
+}
+
+bool rlCheckRenderBatchLimit(int vCount)
+{
+    if (render_batch.vertexCount + vCount <= RAYLIB_JS_BATCH_MAX_VERTICES) return false;
+    submit_batch();
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Shapes, same as in rshapes.c of raylib
+//----------------------------------------------------------------------------------
+// The bounds of the points, grown by margin on every side
+static bool points_visible(const Vector2 *points, int pointCount, float margin)
+{
+    Vector2 min = points[0];
+    Vector2 max = points[0];
+    for (int i = 1; i < pointCount; ++i) {
+        if (points[i].x < min.x) min.x = points[i].x;
+        if (points[i].y < min.y) min.y = points[i].y;
+        if (points[i].x > max.x) max.x = points[i].x;
+        if (points[i].y > max.y) max.y = points[i].y;
+    }
+    return raylib_js_visible((Rectangle){ min.x - margin, min.y - margin, max.x - min.x + 2*margin, max.y - min.y + 2*margin });
+}
+
+void DrawLineV(Vector2 startPos, Vector2 endPos, Color color)
+{
+    if (!points_visible((Vector2[]){ startPos, endPos }, 2, 1.0f)) return;
+    rlBegin(RL_LINES);
+        rlColor4ub(color.r, color.g, color.b, color.a);
+        rlVertex2f(startPos.x, startPos.y);
+        rlVertex2f(endPos.x, endPos.y);
+    rlEnd();
+}
+
+void DrawLine(int startPosX, int startPosY, int endPosX, int endPosY, Color color)
+{
+    DrawLineV((Vector2){ startPosX, startPosY }, (Vector2){ endPosX, endPosY }, color);
+}
+
+void DrawTriangleStrip(Vector2 *points, int pointCount, Color color)
+{
+    if (pointCount < 3 || !points_visible(points, pointCount, 0.0f)) return;
+    rlBegin(RL_TRIANGLES);
+        rlColor4ub(color.r, color.g, color.b, color.a);
+        for (int i = 2; i < pointCount; ++i) {
+            if ((i%2) == 0) {
+                rlVertex2f(points[i].x, points[i].y);
+                rlVertex2f(points[i - 2].x, points[i - 2].y);
+                rlVertex2f(points[i - 1].x, points[i - 1].y);
+            } else {
+                rlVertex2f(points[i].x, points[i].y);
+                rlVertex2f(points[i - 1].x, points[i - 1].y);
+                rlVertex2f(points[i - 2].x, points[i - 2].y);
+            }
+        }
+    rlEnd();
+}
+
+void DrawLineEx(Vector2 startPos, Vector2 endPos, float thick, Color color)
+{
+    Vector2 delta = { endPos.x - startPos.x, endPos.y - startPos.y };
+    float length = __builtin_sqrtf(delta.x*delta.x + delta.y*delta.y);
+    if (length > 0 && thick > 0) {
+        float scale = thick/(2*length);
+        Vector2 radius = { -scale*delta.y, scale*delta.x };
+        Vector2 strip[4] = {
+            { startPos.x - radius.x, startPos.y - radius.y },
+            { startPos.x + radius.x, startPos.y + radius.y },
+            { endPos.x - radius.x, endPos.y - radius.y },
+            { endPos.x + radius.x, endPos.y + radius.y },
+        };
+        DrawTriangleStrip(strip, 4, color);
+    }
+}
+
+void DrawTriangle(Vector2 v1, Vector2 v2, Vector2 v3, Color color)
+{
+    if (!points_visible((Vector2[]){ v1, v2, v3 }, 3, 0.0f)) return;
+    rlBegin(RL_TRIANGLES);
+        rlColor4ub(color.r, color.g, color.b, color.a);
+        rlVertex2f(v1.x, v1.y);
+        rlVertex2f(v2.x, v2.y);
+        rlVertex2f(v3.x, v3.y);
+    rlEnd();
+}
+
+void DrawTriangleLines(Vector2 v1, Vector2 v2, Vector2 v3, Color color)
+{
+    if (!points_visible((Vector2[]){ v1, v2, v3 }, 3, 1.0f)) return;
+    rlBegin(RL_LINES);
+        rlColor4ub(color.r, color.g, color.b, color.a);
+        rlVertex2f(v1.x, v1.y);
+        rlVertex2f(v2.x, v2.y);
+
+        rlVertex2f(v2.x, v2.y);
+        rlVertex2f(v3.x, v3.y);
+
+        rlVertex2f(v3.x, v3.y);
+        rlVertex2f(v1.x, v1.y);
+    rlEnd();
+}
+
+void DrawTriangleFan(Vector2 *points, int pointCount, Color color)
+{
+    if (pointCount < 3 || !points_visible(points, pointCount, 0.0f)) return;
+    rlBegin(RL_TRIANGLES);
+        rlColor4ub(color.r, color.g, color.b, color.a);
+        for (int i = 1; i < pointCount - 1; ++i) {
+            rlVertex2f(points[0].x, points[0].y);
+            rlVertex2f(points[i].x, points[i].y);
+            rlVertex2f(points[i + 1].x, points[i + 1].y);
+        }
+    rlEnd();
+}
+
+// The points of a regular polygon. Every point is the previous one rotated by the central angle,
+// so cosf() and sinf(), which are imported from JavaScript, are only called twice per polygon.
+static void polygon_points(Vector2 center, int sides, float radius, float rotation, Vector2 *points)
+{
+    float angleStep = 360.0f/(float)sides*DEG2RAD;
+    float stepCos = cosf(angleStep);
+    float stepSin = sinf(angleStep);
+    float x = cosf(rotation*DEG2RAD)*radius;
+    float y = sinf(rotation*DEG2RAD)*radius;
+    for (int i = 0; i <= sides; ++i) {
+        points[i] = (Vector2){ center.x + x, center.y + y };
+        float nextX = x*stepCos - y*stepSin;
+        y = x*stepSin + y*stepCos;
+        x = nextX;
+    }
+}
+
+#define MAX_POLYGON_SIDES 256
+
+void DrawPoly(Vector2 center, int sides, float radius, float rotation, Color color)
+{
+    if (sides < 3) sides = 3;
+    if (sides > MAX_POLYGON_SIDES) sides = MAX_POLYGON_SIDES;
+    if (!points_visible(&center, 1, __builtin_fabsf(radius))) return;
+    Vector2 points[MAX_POLYGON_SIDES + 1];
+    polygon_points(center, sides, radius, rotation, points);
+    rlBegin(RL_TRIANGLES);
+        rlColor4ub(color.r, color.g, color.b, color.a);
+        for (int i = 0; i < sides; ++i) {
+            rlVertex2f(center.x, center.y);
+            rlVertex2f(points[i].x, points[i].y);
+            rlVertex2f(points[i + 1].x, points[i + 1].y);
+        }
+    rlEnd();
+}
+
+void DrawPolyLines(Vector2 center, int sides, float radius, float rotation, Color color)
+{
+    if (sides < 3) sides = 3;
+    if (sides > MAX_POLYGON_SIDES) sides = MAX_POLYGON_SIDES;
+    if (!points_visible(&center, 1, __builtin_fabsf(radius) + 1.0f)) return;
+    Vector2 points[MAX_POLYGON_SIDES + 1];
+    polygon_points(center, sides, radius, rotation, points);
+    rlBegin(RL_LINES);
+        rlColor4ub(color.r, color.g, color.b, color.a);
+        for (int i = 0; i < sides; ++i) {
+            rlVertex2f(points[i].x, points[i].y);
+            rlVertex2f(points[i + 1].x, points[i + 1].y);
+        }
+    rlEnd();
+}
+
+#endif // RAYLIB_JS_RLGL
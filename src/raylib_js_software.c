@@ -0,0 +1,1160 @@
+// Software renderer for PLATFORM_WEB builds compiled with -DRAYLIB_JS_SOFTWARE_RENDERER.
+//
+// The drawing functions below rasterize into a framebuffer in the linear memory instead of
+// calling into JavaScript, and raylib.js puts the whole frame on the canvas with a single
+// putImageData() in EndDrawing(). A frame costs the same single boundary crossing no matter how
+// much it draws, and the pixels it produces don't depend on the browser or the GPU, so the
+// framebuffer can be compared against golden images in headless tests.
+//
+// The spans are filled and blended 4 pixels at a time with wasm SIMD when compiled with
+// -msimd128, which nob.c does when the renderer is enabled.
+#ifdef RAYLIB_JS_SOFTWARE_RENDERER
+
+#include <stddef.h>
+#include <math.h>
+#include <raylib.h>
+#define RAYMATH_STATIC_INLINE
+#include <raymath.h>
+#include "raylib_js.h"
+
+#ifdef __wasm_simd128__
+#include <wasm_simd128.h>
+#endif
+
+typedef struct {
+    unsigned int id;                // The id raylib.js gave the texture, 0 if the slot is free
+    const unsigned int *pixels;     // RGBA as 0xAABBGGRR, row by row
+    int width;
+    int height;
+    bool inArena;                   // The pixels were copied into texture_arena
+} SoftwareTexture;
+
+// NOTE: not initialized statically, so it takes no space in the module
+static RaylibJsFramebuffer framebuffer;
+
+static SoftwareTexture textures[RAYLIB_JS_SOFTWARE_MAX_TEXTURES];   // By the slot of the id
+static unsigned int texture_arena[RAYLIB_JS_SOFTWARE_TEXTURE_ARENA];
+static unsigned int texture_arena_used = 0;
+static unsigned int texture_arena_count = 0;
+
+// The depth buffer of the 3D mode is cleared lazily, see BeginMode3D()
+static bool depth_cleared = false;
+
+RAYLIB_JS_EXPORT(raylib_js_framebuffer)
+RaylibJsFramebuffer *raylib_js_framebuffer(void)
+{
+    framebuffer.capacity = RAYLIB_JS_FRAMEBUFFER_CAPACITY;
+    return &framebuffer;
+}
+
+static SoftwareTexture *texture_slot(unsigned int id)
+{
+    unsigned int slot = (id & 0xFFFF) - 1;
+    if (slot >= RAYLIB_JS_SOFTWARE_MAX_TEXTURES) return NULL;
+    return &textures[slot];
+}
+
+static SoftwareTexture *texture_by_id(unsigned int id)
+{
+    SoftwareTexture *texture = texture_slot(id);
+    if (texture == NULL || texture->id != id || texture->pixels == NULL) return NULL;
+    return texture;
+}
+
+RAYLIB_JS_EXPORT(raylib_js_software_unbind_texture)
+void raylib_js_software_unbind_texture(unsigned int id)
+{
+    SoftwareTexture *texture = texture_slot(id);
+    if (texture == NULL || texture->id != id) return;
+    if (texture->inArena) {
+        // The arena only starts over once all the textures in it are unloaded, which is what
+        // games do when they switch levels anyway
+        texture_arena_count -= 1;
+        if (texture_arena_count == 0) texture_arena_used = 0;
+    }
+    texture->id = 0;
+    texture->pixels = NULL;
+    texture->inArena = false;
+}
+
+// Lets the texture draw straight from pixels the game owns, like the data of an Image
+RAYLIB_JS_EXPORT(raylib_js_software_bind_texture)
+bool raylib_js_software_bind_texture(unsigned int id, const unsigned int *pixels, int width, int height)
+{
+    SoftwareTexture *texture = texture_slot(id);
+    if (texture == NULL) return false;
+    if (texture->id != id) raylib_js_software_unbind_texture(texture->id);
+    texture->id = id;
+    texture->pixels = pixels;
+    texture->width = width;
+    texture->height = height;
+    return true;
+}
+
+// Returns where raylib.js copies the pixels of a texture loaded from a file to, or NULL if they
+// don't fit
+RAYLIB_JS_EXPORT(raylib_js_software_texture_pixels)
+unsigned int *raylib_js_software_texture_pixels(unsigned int id, int width, int height)
+{
+    unsigned int size = (unsigned int)width*(unsigned int)height;
+    if (size > RAYLIB_JS_SOFTWARE_TEXTURE_ARENA - texture_arena_used) return NULL;
+    unsigned int *pixels = &texture_arena[texture_arena_used];
+    if (!raylib_js_software_bind_texture(id, pixels, width, height)) return NULL;
+    texture_arena_used += size;
+    texture_arena_count += 1;
+    texture_slot(id)->inArena = true;
+    return pixels;
+}
+
+//----------------------------------------------------------------------------------
+// Spans
+//----------------------------------------------------------------------------------
+static unsigned int color_pack(Color color)
+{
+    return color.r | (color.g << 8) | (color.b << 16) | ((unsigned int)color.a << 24);
+}
+
+// x/255 rounded, exact for all the products of two bytes
+static inline unsigned int div255(unsigned int x)
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+// Same as BLEND_ALPHA of raylib: out = src*a + dst*(1 - a), and the alphas add up the same way
+static inline unsigned int blend(unsigned int dst, unsigned int src)
+{
+    unsigned int a = src >> 24;
+    if (a == 255) return src;
+    if (a == 0) return dst;
+    unsigned int ia = 255 - a;
+    unsigned int r = div255((src & 0xFF)*a + (dst & 0xFF)*ia);
+    unsigned int g = div255(((src >> 8) & 0xFF)*a + ((dst >> 8) & 0xFF)*ia);
+    unsigned int b = div255(((src >> 16) & 0xFF)*a + ((dst >> 16) & 0xFF)*ia);
+    unsigned int outA = div255(255*a + (dst >> 24)*ia);
+    return r | (g << 8) | (b << 16) | (outA << 24);
+}
+
+// Multiplies every channel like the tint does in raylib
+static inline unsigned int modulate(unsigned int color, unsigned int tint)
+{
+    return div255((color & 0xFF)*(tint & 0xFF))
+         | (div255(((color >> 8) & 0xFF)*((tint >> 8) & 0xFF)) << 8)
+         | (div255(((color >> 16) & 0xFF)*((tint >> 16) & 0xFF)) << 16)
+         | (div255((color >> 24)*(tint >> 24)) << 24);
+}
+
+#ifdef __wasm_simd128__
+// div255() of the 8 16-bit lanes
+static inline v128_t div255x8(v128_t x)
+{
+    x = wasm_i16x8_add(x, wasm_i16x8_splat(128));
+    return wasm_u16x8_shr(wasm_i16x8_add(x, wasm_u16x8_shr(x, 8)), 8);
+}
+
+// blend() of 4 pixels, each with its own alpha
+static inline v128_t blend4(v128_t dst, v128_t src)
+{
+    v128_t alpha = wasm_i8x16_shuffle(src, src, 3, 3, 3, 3, 7, 7, 7, 7, 11, 11, 11, 11, 15, 15, 15, 15);
+    // With 255 in place of the alpha of src, its alpha lane comes out as 255*a like in blend()
+    v128_t opaque = wasm_v128_or(src, wasm_i32x4_splat(0xFF000000));
+    v128_t full = wasm_i16x8_splat(255);
+    v128_t alphaLo = wasm_u16x8_extend_low_u8x16(alpha);
+    v128_t alphaHi = wasm_u16x8_extend_high_u8x16(alpha);
+    v128_t lo = wasm_i16x8_add(wasm_i16x8_mul(wasm_u16x8_extend_low_u8x16(opaque), alphaLo),
+                               wasm_i16x8_mul(wasm_u16x8_extend_low_u8x16(dst), wasm_i16x8_sub(full, alphaLo)));
+    v128_t hi = wasm_i16x8_add(wasm_i16x8_mul(wasm_u16x8_extend_high_u8x16(opaque), alphaHi),
+                               wasm_i16x8_mul(wasm_u16x8_extend_high_u8x16(dst), wasm_i16x8_sub(full, alphaHi)));
+    return wasm_u8x16_narrow_i16x8(div255x8(lo), div255x8(hi));
+}
+
+// modulate() of 4 pixels by the same tint
+static inline v128_t modulate4(v128_t color, v128_t tint)
+{
+    v128_t tintLo = wasm_u16x8_extend_low_u8x16(tint);
+    v128_t lo = wasm_i16x8_mul(wasm_u16x8_extend_low_u8x16(color), tintLo);
+    v128_t hi = wasm_i16x8_mul(wasm_u16x8_extend_high_u8x16(color), tintLo);
+    return wasm_u8x16_narrow_i16x8(div255x8(lo), div255x8(hi));
+}
+#endif
+
+// Fills count pixels starting at dst with the color
+static void fill_span(unsigned int *dst, int count, unsigned int color)
+{
+    unsigned int a = color >> 24;
+    if (a == 0) return;
+    int i = 0;
+    if (a == 255) {
+#ifdef __wasm_simd128__
+        v128_t src = wasm_i32x4_splat(color);
+        for (; i + 4 <= count; i += 4) wasm_v128_store(dst + i, src);
+#endif
+        for (; i < count; ++i) dst[i] = color;
+        return;
+    }
+#ifdef __wasm_simd128__
+    // The same color all the way, so only the destination has to be multiplied per pixel
+    v128_t src = wasm_i16x8_mul(wasm_u16x8_extend_low_u8x16(wasm_i32x4_splat(color | 0xFF000000)), wasm_i16x8_splat(a));
+    v128_t ia = wasm_i16x8_splat(255 - a);
+    for (; i + 4 <= count; i += 4) {
+        v128_t d = wasm_v128_load(dst + i);
+        v128_t lo = wasm_i16x8_add(src, wasm_i16x8_mul(wasm_u16x8_extend_low_u8x16(d), ia));
+        v128_t hi = wasm_i16x8_add(src, wasm_i16x8_mul(wasm_u16x8_extend_high_u8x16(d), ia));
+        wasm_v128_store(dst + i, wasm_u8x16_narrow_i16x8(div255x8(lo), div255x8(hi)));
+    }
+#endif
+    for (; i < count; ++i) dst[i] = blend(dst[i], color);
+}
+
+// Blends count texels tinted by the tint over the pixels starting at dst
+static void blend_span(unsigned int *dst, const unsigned int *texels, int count, unsigned int tint)
+{
+    int i = 0;
+#ifdef __wasm_simd128__
+    v128_t tint4 = wasm_i32x4_splat(tint);
+    for (; i + 4 <= count; i += 4) {
+        v128_t src = wasm_v128_load(texels + i);
+        if (tint != 0xFFFFFFFF) src = modulate4(src, tint4);
+        wasm_v128_store(dst + i, blend4(wasm_v128_load(dst + i), src));
+    }
+#endif
+    for (; i < count; ++i) {
+        unsigned int src = texels[i];
+        if (tint != 0xFFFFFFFF) src = modulate(src, tint);
+        dst[i] = blend(dst[i], src);
+    }
+}
+
+// The pixels whose centers are in [from, to)
+static inline int pixel_ceil(float x)
+{
+    int i = (int)x;
+    return (x > (float)i) ? i + 1 : i;
+}
+
+static inline int pixel_floor(float x)
+{
+    int i = (int)x;
+    return (x < (float)i) ? i - 1 : i;
+}
+
+static inline int clamp(int x, int min, int max)
+{
+    return x < min ? min : (x > max ? max : x);
+}
+
+static void fill_rect(float x, float y, float width, float height, unsigned int color)
+{
+    int x0 = clamp(pixel_ceil(x - 0.5f), 0, framebuffer.width);
+    int x1 = clamp(pixel_ceil(x + width - 0.5f), 0, framebuffer.width);
+    int y0 = clamp(pixel_ceil(y - 0.5f), 0, framebuffer.height);
+    int y1 = clamp(pixel_ceil(y + height - 0.5f), 0, framebuffer.height);
+    if (x0 >= x1) return;
+    for (int py = y0; py < y1; ++py) fill_span(&framebuffer.pixels[py*framebuffer.width + x0], x1 - x0, color);
+}
+
+// Fills the convex polygon, in either winding order, one span per row. Every edge cuts the row
+// to the side of it the polygon is on.
+static void fill_convex(const Vector2 *points, int count, unsigned int color)
+{
+    float area = 0.0f;
+    float minY = points[0].y;
+    float maxY = points[0].y;
+    for (int i = 0; i < count; ++i) {
+        Vector2 a = points[i];
+        Vector2 b = points[(i + 1)%count];
+        area += a.x*b.y - b.x*a.y;
+        if (b.y < minY) minY = b.y;
+        if (b.y > maxY) maxY = b.y;
+    }
+    if (area == 0.0f) return;
+    float sign = area > 0.0f ? 1.0f : -1.0f;
+
+    int y0 = clamp(pixel_ceil(minY - 0.5f), 0, framebuffer.height);
+    int y1 = clamp(pixel_floor(maxY - 0.5f) + 1, 0, framebuffer.height);
+    for (int py = y0; py < y1; ++py) {
+        float centerY = py + 0.5f;
+        float from = 0.0f;
+        float to = (float)framebuffer.width;
+        for (int i = 0; i < count && from < to; ++i) {
+            Vector2 a = points[i];
+            Vector2 b = points[(i + 1)%count];
+            // Inside when sign*cross(b - a, p - a) >= 0, which is slope*x + offset >= 0 on this row
+            float slope = -sign*(b.y - a.y);
+            float offset = sign*((b.x - a.x)*(centerY - a.y) + (b.y - a.y)*a.x);
+            if (slope > 0.0f) {
+                float x = -offset/slope;
+                if (x > from) from = x;
+            } else if (slope < 0.0f) {
+                float x = -offset/slope;
+                if (x < to) to = x;
+            } else if (offset < 0.0f) {
+                to = from;
+            }
+        }
+        int x0 = clamp(pixel_ceil(from - 0.5f), 0, framebuffer.width);
+        int x1 = clamp(pixel_floor(to - 0.5f) + 1, 0, framebuffer.width);
+        if (x0 < x1) fill_span(&framebuffer.pixels[py*framebuffer.width + x0], x1 - x0, color);
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Shapes
+//----------------------------------------------------------------------------------
+void ClearBackground(Color color)
+{
+    depth_cleared = false;
+    unsigned int packed = color_pack(color) | 0xFF000000;
+    int count = framebuffer.width*framebuffer.height;
+    int i = 0;
+#ifdef __wasm_simd128__
+    v128_t src = wasm_i32x4_splat(packed);
+    for (; i + 4 <= count; i += 4) wasm_v128_store(&framebuffer.pixels[i], src);
+#endif
+    for (; i < count; ++i) framebuffer.pixels[i] = packed;
+}
+
+void DrawRectangle(int posX, int posY, int width, int height, Color color)
+{
+    fill_rect(posX, posY, width, height, color_pack(color));
+}
+
+void DrawRectangleV(Vector2 position, Vector2 size, Color color)
+{
+    fill_rect(position.x, position.y, size.x, size.y, color_pack(color));
+}
+
+void DrawRectangleRec(Rectangle rec, Color color)
+{
+    fill_rect(rec.x, rec.y, rec.width, rec.height, color_pack(color));
+}
+
+void DrawRectangleLinesEx(Rectangle rec, float lineThick, Color color)
+{
+    unsigned int packed = color_pack(color);
+    if (lineThick > rec.width/2) lineThick = rec.width/2;
+    if (lineThick > rec.height/2) lineThick = rec.height/2;
+    fill_rect(rec.x, rec.y, rec.width, lineThick, packed);
+    fill_rect(rec.x, rec.y + rec.height - lineThick, rec.width, lineThick, packed);
+    fill_rect(rec.x, rec.y + lineThick, lineThick, rec.height - 2*lineThick, packed);
+    fill_rect(rec.x + rec.width - lineThick, rec.y + lineThick, lineThick, rec.height - 2*lineThick, packed);
+}
+
+void DrawRectangleLines(int posX, int posY, int width, int height, Color color)
+{
+    DrawRectangleLinesEx((Rectangle){ posX, posY, width, height }, 1.0f, color);
+}
+
+void DrawCircleV(Vector2 center, float radius, Color color)
+{
+    unsigned int packed = color_pack(color);
+    int y0 = clamp(pixel_ceil(center.y - radius - 0.5f), 0, framebuffer.height);
+    int y1 = clamp(pixel_floor(center.y + radius - 0.5f) + 1, 0, framebuffer.height);
+    for (int py = y0; py < y1; ++py) {
+        float dy = py + 0.5f - center.y;
+        float dx2 = radius*radius - dy*dy;
+        if (dx2 < 0.0f) continue;
+        float dx = __builtin_sqrtf(dx2);
+        int x0 = clamp(pixel_ceil(center.x - dx - 0.5f), 0, framebuffer.width);
+        int x1 = clamp(pixel_floor(center.x + dx - 0.5f) + 1, 0, framebuffer.width);
+        if (x0 < x1) fill_span(&framebuffer.pixels[py*framebuffer.width + x0], x1 - x0, packed);
+    }
+}
+
+void DrawCircle(int centerX, int centerY, float radius, Color color)
+{
+    DrawCircleV((Vector2){ centerX, centerY }, radius, color);
+}
+
+void DrawLineEx(Vector2 startPos, Vector2 endPos, float thick, Color color)
+{
+    float dx = endPos.x - startPos.x;
+    float dy = endPos.y - startPos.y;
+    float length = __builtin_sqrtf(dx*dx + dy*dy);
+    if (length == 0.0f) return;
+    float nx = -dy/length*thick/2;
+    float ny = dx/length*thick/2;
+    Vector2 quad[4] = {
+        { startPos.x + nx, startPos.y + ny },
+        { endPos.x + nx, endPos.y + ny },
+        { endPos.x - nx, endPos.y - ny },
+        { startPos.x - nx, startPos.y - ny },
+    };
+    fill_convex(quad, 4, color_pack(color));
+}
+
+void DrawLineV(Vector2 startPos, Vector2 endPos, Color color)
+{
+    DrawLineEx(startPos, endPos, 1.0f, color);
+}
+
+void DrawLine(int startPosX, int startPosY, int endPosX, int endPosY, Color color)
+{
+    // Through the centers of the pixels, so the horizontal and vertical lines cover whole pixels
+    DrawLineEx((Vector2){ startPosX + 0.5f, startPosY + 0.5f }, (Vector2){ endPosX + 0.5f, endPosY + 0.5f }, 1.0f, color);
+}
+
+void DrawTriangle(Vector2 v1, Vector2 v2, Vector2 v3, Color color)
+{
+    Vector2 triangle[3] = { v1, v2, v3 };
+    fill_convex(triangle, 3, color_pack(color));
+}
+
+//----------------------------------------------------------------------------------
+// Textures
+//----------------------------------------------------------------------------------
+#define TEXTURE_SPAN_BATCH 64
+
+void DrawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint)
+{
+    const SoftwareTexture *software = texture_by_id(texture.id);
+    if (software == NULL || dest.width == 0.0f || dest.height == 0.0f) return;
+    unsigned int packedTint = color_pack(tint);
+    if ((packedTint >> 24) == 0) return;
+
+    // The negative width or height of the source flips the texture as in raylib
+    bool flipX = source.width < 0;
+    bool flipY = source.height < 0;
+    if (flipX) source.width = -source.width;
+    if (flipY) source.height = -source.height;
+
+    // Maps the pixels back into the destination rectangle before the rotation, relative to its
+    // top left corner
+    float sinR = 0.0f;
+    float cosR = 1.0f;
+    if (rotation != 0.0f) {
+        sinR = sinf(rotation*DEG2RAD);
+        cosR = cosf(rotation*DEG2RAD);
+    }
+    Vector2 corners[4] = {
+        { -origin.x, -origin.y },
+        { dest.width - origin.x, -origin.y },
+        { dest.width - origin.x, dest.height - origin.y },
+        { -origin.x, dest.height - origin.y },
+    };
+    float minX = 1e30f, minY = 1e30f, maxX = -1e30f, maxY = -1e30f;
+    for (int i = 0; i < 4; ++i) {
+        float x = dest.x + corners[i].x*cosR - corners[i].y*sinR;
+        float y = dest.y + corners[i].x*sinR + corners[i].y*cosR;
+        if (x < minX) minX = x;
+        if (x > maxX) maxX = x;
+        if (y < minY) minY = y;
+        if (y > maxY) maxY = y;
+    }
+    int x0 = clamp(pixel_ceil(minX - 0.5f), 0, framebuffer.width);
+    int x1 = clamp(pixel_floor(maxX - 0.5f) + 1, 0, framebuffer.width);
+    int y0 = clamp(pixel_ceil(minY - 0.5f), 0, framebuffer.height);
+    int y1 = clamp(pixel_floor(maxY - 0.5f) + 1, 0, framebuffer.height);
+
+    float scaleU = source.width/dest.width;
+    float scaleV = source.height/dest.height;
+    unsigned int texels[TEXTURE_SPAN_BATCH];
+    for (int py = y0; py < y1; ++py) {
+        int run = 0;
+        int runStart = 0;
+        for (int px = x0; px <= x1; ++px) {
+            bool inside = false;
+            if (px < x1) {
+                float rx = px + 0.5f - dest.x;
+                float ry = py + 0.5f - dest.y;
+                float lx = rx*cosR + ry*sinR + origin.x;
+                float ly = -rx*sinR + ry*cosR + origin.y;
+                if (lx >= 0.0f && lx < dest.width && ly >= 0.0f && ly < dest.height) {
+                    int u = (int)((flipX ? dest.width - lx : lx)*scaleU + source.x);
+                    int v = (int)((flipY ? dest.height - ly : ly)*scaleV + source.y);
+                    u = clamp(u, 0, software->width - 1);
+                    v = clamp(v, 0, software->height - 1);
+                    if (run == 0) runStart = px;
+                    texels[run++] = software->pixels[v*software->width + u];
+                    inside = true;
+                }
+            }
+            // Blend the texels sampled so far in one go
+            if (run > 0 && (!inside || run == TEXTURE_SPAN_BATCH)) {
+                blend_span(&framebuffer.pixels[py*framebuffer.width + runStart], texels, run, packedTint);
+                run = 0;
+            }
+        }
+    }
+}
+
+void DrawTexture(Texture2D texture, int posX, int posY, Color tint)
+{
+    // NOTE: the textures that were not preloaded have a size of 0 until they are decoded
+    const SoftwareTexture *software = texture_by_id(texture.id);
+    if (software == NULL) return;
+    Rectangle source = { 0, 0, software->width, software->height };
+    Rectangle dest = { posX, posY, software->width, software->height };
+    DrawTexturePro(texture, source, dest, (Vector2){ 0, 0 }, 0.0f, tint);
+}
+
+//----------------------------------------------------------------------------------
+// Text, always in the default font
+//----------------------------------------------------------------------------------
+void DrawTextEx(Font font, const char *text, Vector2 position, float fontSize, float spacing, Color tint)
+{
+    (void)font;
+    const RaylibJsDefaultFont *defaultFont = raylib_js_default_font();
+    unsigned int color = color_pack(tint);
+    float scale = fontSize/defaultFont->baseSize;
+    float offsetX = 0.0f;
+    float offsetY = 0.0f;
+    const unsigned char *s = (const unsigned char *)text;
+    while (*s != '\0') {
+        int codepoint = raylib_js_next_codepoint(&s);
+        if (codepoint == '\n') {
+            offsetX = 0.0f;
+            offsetY += fontSize + RAYLIB_JS_DEFAULT_FONT_LINE_SPACING;
+            continue;
+        }
+        int index = codepoint - ' ';
+        if (index < 0 || index >= defaultFont->glyphCount) index = '?' - ' ';
+        Rectangle rec = defaultFont->recs[index];
+        float glyphX = position.x + offsetX;
+        float glyphY = position.y + offsetY;
+        if (codepoint != ' ' && codepoint != '\t') {
+            // Every pixel of the glyph scaled up to a block of pixels
+            int x0 = clamp(pixel_ceil(glyphX - 0.5f), 0, framebuffer.width);
+            int x1 = clamp(pixel_ceil(glyphX + rec.width*scale - 0.5f), 0, framebuffer.width);
+            int y0 = clamp(pixel_ceil(glyphY - 0.5f), 0, framebuffer.height);
+            int y1 = clamp(pixel_ceil(glyphY + rec.height*scale - 0.5f), 0, framebuffer.height);
+            for (int py = y0; py < y1; ++py) {
+                int atlasY = (int)rec.y + (int)((py + 0.5f - glyphY)/scale);
+                for (int px = x0; px < x1; ++px) {
+                    int atlasX = (int)rec.x + (int)((px + 0.5f - glyphX)/scale);
+                    int bit = atlasY*defaultFont->atlasWidth + atlasX;
+                    if ((defaultFont->atlas[bit >> 5] >> (bit & 31)) & 1) {
+                        unsigned int *pixel = &framebuffer.pixels[py*framebuffer.width + px];
+                        *pixel = blend(*pixel, color);
+                    }
+                }
+            }
+        }
+        offsetX += rec.width*scale + spacing;
+    }
+}
+
+void DrawText(const char *text, int posX, int posY, int fontSize, Color color)
+{
+    // Same as DrawText() of raylib
+    if (fontSize < RAYLIB_JS_DEFAULT_FONT_BASE_SIZE) fontSize = RAYLIB_JS_DEFAULT_FONT_BASE_SIZE;
+    int spacing = fontSize/RAYLIB_JS_DEFAULT_FONT_BASE_SIZE;
+    DrawTextEx((Font){0}, text, (Vector2){ posX, posY }, fontSize, spacing, color);
+}
+
+//----------------------------------------------------------------------------------
+// 3D
+//----------------------------------------------------------------------------------
+// The triangles are transformed into the clip space, clipped against the frustum and filled tile
+// by tile with edge functions in fixed point, testing and writing the depth buffer like the
+// default state of rlgl does: LEQUAL, back faces culled. A triangle has the color of the material,
+// or the colors of its vertices interpolated across it, which are lit first once
+// SetSoftwareLight() turned the light on: flat with the normal of the face, or at every vertex
+// with the normals of the mesh.
+#define CULL_DISTANCE_NEAR 0.01     // Same as RL_CULL_DISTANCE_NEAR of rlgl
+#define CULL_DISTANCE_FAR 1000.0    // Same as RL_CULL_DISTANCE_FAR of rlgl
+#define RASTER_SUBPIXEL_BITS 4
+#define RASTER_SUBPIXELS (1 << RASTER_SUBPIXEL_BITS)
+#define RASTER_TILE_SIZE 8
+#define MAX_CLIPPED_VERTICES 9      // A triangle clipped by the 6 planes of the frustum
+#define LINE_DEPTH_BIAS 1e-6f
+
+// The edge functions of a triangle covering the whole framebuffer have to fit into an int
+_Static_assert(RAYLIB_JS_FRAMEBUFFER_CAPACITY < (1 << (31 - 2*RASTER_SUBPIXEL_BITS - 1)),
+               "RAYLIB_JS_FRAMEBUFFER_CAPACITY is too big for the fixed point of the rasterizer");
+
+typedef struct {
+    float position[4];      // Clip space
+    float color[4];         // RGBA, 0 to 255
+} Vertex3D;
+
+// The columns of the model-view-projection matrix, so a vertex is transformed with 4 wide
+// multiply-adds
+typedef struct {
+    float columns[4][4];
+} Transform3D;
+
+typedef struct {
+    int stepX[3];           // How the edge functions change from one pixel to the next
+    int stepY[3];
+    float invArea;
+    float z0, dz1, dz2;     // Depth of the vertex 0, and of the other two relative to it
+    float color0[4], dcolor1[4], dcolor2[4];
+    bool flat;              // All the vertices have the same color
+    bool opaque;
+    unsigned int color;     // Of the flat triangles
+} Raster;
+
+static Matrix view_projection;      // Of the camera of BeginMode3D()
+static bool light_enabled = false;
+static Vector3 light_towards;       // Normalized, from the surfaces towards the light
+static float light_ambient;
+static float depthbuffer[RAYLIB_JS_FRAMEBUFFER_CAPACITY];
+
+static void clear_depth(void)
+{
+    int count = framebuffer.width*framebuffer.height;
+    int i = 0;
+#ifdef __wasm_simd128__
+    v128_t far = wasm_f32x4_splat(1.0f);
+    for (; i + 4 <= count; i += 4) wasm_v128_store(&depthbuffer[i], far);
+#endif
+    for (; i < count; ++i) depthbuffer[i] = 1.0f;
+    depth_cleared = true;
+}
+
+void BeginMode3D(Camera3D camera)
+{
+    // Cleared here instead of in ClearBackground(), so the games that draw only 2D never pay for it
+    if (!depth_cleared) clear_depth();
+    double aspect = (double)framebuffer.width/(double)framebuffer.height;
+    Matrix projection;
+    if (camera.projection == CAMERA_PERSPECTIVE) {
+        projection = MatrixPerspective(camera.fovy*DEG2RAD, aspect, CULL_DISTANCE_NEAR, CULL_DISTANCE_FAR);
+    } else {
+        double top = camera.fovy/2.0;
+        double right = top*aspect;
+        projection = MatrixOrtho(-right, right, -top, top, CULL_DISTANCE_NEAR, CULL_DISTANCE_FAR);
+    }
+    view_projection = MatrixMultiply(MatrixLookAt(camera.position, camera.target, camera.up), projection);
+}
+
+void EndMode3D(void)
+{
+}
+
+static Transform3D transform_3d(Matrix model)
+{
+    Matrix mvp = MatrixMultiply(model, view_projection);
+    return (Transform3D){{
+        { mvp.m0, mvp.m1, mvp.m2, mvp.m3 },
+        { mvp.m4, mvp.m5, mvp.m6, mvp.m7 },
+        { mvp.m8, mvp.m9, mvp.m10, mvp.m11 },
+        { mvp.m12, mvp.m13, mvp.m14, mvp.m15 },
+    }};
+}
+
+static Vertex3D transform_vertex(const Transform3D *transform, float x, float y, float z, const float *color)
+{
+    Vertex3D vertex;
+#ifdef __wasm_simd128__
+    v128_t position = wasm_f32x4_add(wasm_f32x4_mul(wasm_v128_load(transform->columns[0]), wasm_f32x4_splat(x)),
+                                     wasm_f32x4_mul(wasm_v128_load(transform->columns[1]), wasm_f32x4_splat(y)));
+    position = wasm_f32x4_add(position, wasm_f32x4_mul(wasm_v128_load(transform->columns[2]), wasm_f32x4_splat(z)));
+    wasm_v128_store(vertex.position, wasm_f32x4_add(position, wasm_v128_load(transform->columns[3])));
+#else
+    for (int i = 0; i < 4; ++i) {
+        float position = transform->columns[0][i]*x + transform->columns[1][i]*y;
+        position = position + transform->columns[2][i]*z;
+        vertex.position[i] = position + transform->columns[3][i];
+    }
+#endif
+    for (int i = 0; i < 4; ++i) vertex.color[i] = color[i];
+    return vertex;
+}
+
+static void color_floats(Color color, float *out)
+{
+    out[0] = color.r;
+    out[1] = color.g;
+    out[2] = color.b;
+    out[3] = color.a;
+}
+
+void SetSoftwareLight(Vector3 direction, float ambient)
+{
+    light_enabled = Vector3LengthSqr(direction) > 0.0f;
+    if (light_enabled) light_towards = Vector3Negate(Vector3Normalize(direction));
+    light_ambient = Clamp(ambient, 0.0f, 1.0f);
+}
+
+// Lights color on a surface of the normal, in the world space and of any length. out can be color.
+static void shade_color(Vector3 normal, const float *color, float *out)
+{
+    float facing = Vector3DotProduct(Vector3Normalize(normal), light_towards);
+    float intensity = light_ambient + (1.0f - light_ambient)*fmaxf(facing, 0.0f);
+    for (int c = 0; c < 3; ++c) out[c] = color[c]*intensity;
+    out[3] = color[3];
+}
+
+// The normal of the counter-clockwise triangle, of any length
+static Vector3 face_normal(Vector3 a, Vector3 b, Vector3 c)
+{
+    return Vector3CrossProduct(Vector3Subtract(b, a), Vector3Subtract(c, a));
+}
+
+// Takes the normals of the model space into the world space. The inverse transpose keeps them
+// perpendicular to the surfaces when the model is scaled unevenly.
+static Matrix normal_matrix(Matrix model)
+{
+    return MatrixTranspose(MatrixInvert(model));
+}
+
+// How far inside the plane of the frustum the vertex is, negative when outside of it
+static float plane_distance(const Vertex3D *vertex, int plane)
+{
+    float w = vertex->position[3];
+    float coordinate = vertex->position[plane/2];
+    return (plane%2 == 0) ? w + coordinate : w - coordinate;
+}
+
+static Vertex3D lerp_vertex(const Vertex3D *a, const Vertex3D *b, float t)
+{
+    Vertex3D result;
+    for (int i = 0; i < 4; ++i) {
+        result.position[i] = a->position[i] + (b->position[i] - a->position[i])*t;
+        result.color[i] = a->color[i] + (b->color[i] - a->color[i])*t;
+    }
+    return result;
+}
+
+// Sutherland-Hodgman against the 6 planes of the frustum. Returns how many vertices are left in
+// polygon.
+static int clip_polygon(Vertex3D *polygon, int count)
+{
+    Vertex3D clipped[MAX_CLIPPED_VERTICES];
+    for (int plane = 0; plane < 6 && count > 0; ++plane) {
+        int clippedCount = 0;
+        for (int i = 0; i < count; ++i) {
+            const Vertex3D *a = &polygon[i];
+            const Vertex3D *b = &polygon[(i + 1)%count];
+            float da = plane_distance(a, plane);
+            float db = plane_distance(b, plane);
+            if (da >= 0.0f) clipped[clippedCount++] = *a;
+            if ((da >= 0.0f) != (db >= 0.0f)) clipped[clippedCount++] = lerp_vertex(a, b, da/(da - db));
+        }
+        count = clippedCount;
+        for (int i = 0; i < count; ++i) polygon[i] = clipped[i];
+    }
+    return count;
+}
+
+// The top and the left edges own the pixels exactly on them, the others don't
+static inline bool is_top_left(int dx, int dy)
+{
+    return dy < 0 || (dy == 0 && dx > 0);
+}
+
+static inline unsigned int interpolate_color(const Raster *raster, float l1, float l2)
+{
+    unsigned int color = 0;
+    for (int i = 0; i < 4; ++i) {
+        int channel = (int)(raster->color0[i] + l1*raster->dcolor1[i] + l2*raster->dcolor2[i]);
+        color |= (unsigned int)clamp(channel, 0, 255) << (8*i);
+    }
+    return color;
+}
+
+// Fills count pixels of the row py starting from px, with the edge functions w0, w1 and w2 at px.
+// full means the span is entirely inside the triangle.
+static void raster_span(const Raster *raster, int py, int px, int count, int w0, int w1, int w2, bool full)
+{
+    int index = py*framebuffer.width + px;
+    unsigned int *pixels = &framebuffer.pixels[index];
+    float *depth = &depthbuffer[index];
+    int i = 0;
+#ifdef __wasm_simd128__
+    v128_t lanes = wasm_i32x4_make(0, 1, 2, 3);
+    v128_t e0 = wasm_i32x4_add(wasm_i32x4_splat(w0), wasm_i32x4_mul(lanes, wasm_i32x4_splat(raster->stepX[0])));
+    v128_t e1 = wasm_i32x4_add(wasm_i32x4_splat(w1), wasm_i32x4_mul(lanes, wasm_i32x4_splat(raster->stepX[1])));
+    v128_t e2 = wasm_i32x4_add(wasm_i32x4_splat(w2), wasm_i32x4_mul(lanes, wasm_i32x4_splat(raster->stepX[2])));
+    v128_t step0 = wasm_i32x4_splat(4*raster->stepX[0]);
+    v128_t step1 = wasm_i32x4_splat(4*raster->stepX[1]);
+    v128_t step2 = wasm_i32x4_splat(4*raster->stepX[2]);
+    v128_t invArea = wasm_f32x4_splat(raster->invArea);
+    v128_t z0 = wasm_f32x4_splat(raster->z0);
+    v128_t dz1 = wasm_f32x4_splat(raster->dz1);
+    v128_t dz2 = wasm_f32x4_splat(raster->dz2);
+    for (; i + 4 <= count; i += 4) {
+        v128_t inside = full ? wasm_i32x4_splat(-1)
+                             : wasm_i32x4_ge(wasm_v128_or(wasm_v128_or(e0, e1), e2), wasm_i32x4_splat(0));
+        if (wasm_v128_any_true(inside)) {
+            v128_t l1 = wasm_f32x4_mul(wasm_f32x4_convert_i32x4(e1), invArea);
+            v128_t l2 = wasm_f32x4_mul(wasm_f32x4_convert_i32x4(e2), invArea);
+            v128_t z = wasm_f32x4_add(wasm_f32x4_add(z0, wasm_f32x4_mul(l1, dz1)), wasm_f32x4_mul(l2, dz2));
+            v128_t d = wasm_v128_load(depth + i);
+            v128_t pass = wasm_v128_and(inside, wasm_f32x4_le(z, d));
+            wasm_v128_store(depth + i, wasm_v128_bitselect(z, d, pass));
+            v128_t src;
+            if (raster->flat) {
+                src = wasm_i32x4_splat(raster->color);
+            } else {
+                src = wasm_i32x4_splat(0);
+                for (int c = 0; c < 4; ++c) {
+                    v128_t channel = wasm_f32x4_add(wasm_f32x4_add(wasm_f32x4_splat(raster->color0[c]),
+                                                                   wasm_f32x4_mul(l1, wasm_f32x4_splat(raster->dcolor1[c]))),
+                                                    wasm_f32x4_mul(l2, wasm_f32x4_splat(raster->dcolor2[c])));
+                    channel = wasm_i32x4_trunc_sat_f32x4(channel);
+                    channel = wasm_i32x4_min(wasm_i32x4_max(channel, wasm_i32x4_splat(0)), wasm_i32x4_splat(255));
+                    src = wasm_v128_or(src, wasm_i32x4_shl(channel, 8*c));
+                }
+            }
+            v128_t dst = wasm_v128_load(pixels + i);
+            if (!raster->opaque) src = blend4(dst, src);
+            wasm_v128_store(pixels + i, wasm_v128_bitselect(src, dst, pass));
+        }
+        e0 = wasm_i32x4_add(e0, step0);
+        e1 = wasm_i32x4_add(e1, step1);
+        e2 = wasm_i32x4_add(e2, step2);
+    }
+#endif
+    for (; i < count; ++i) {
+        int e0 = w0 + i*raster->stepX[0];
+        int e1 = w1 + i*raster->stepX[1];
+        int e2 = w2 + i*raster->stepX[2];
+        if (!full && (e0 | e1 | e2) < 0) continue;
+        float l1 = (float)e1*raster->invArea;
+        float l2 = (float)e2*raster->invArea;
+        float z = (raster->z0 + l1*raster->dz1) + l2*raster->dz2;
+        if (!(z <= depth[i])) continue;
+        depth[i] = z;
+        unsigned int src = raster->flat ? raster->color : interpolate_color(raster, l1, l2);
+        pixels[i] = raster->opaque ? src : blend(pixels[i], src);
+    }
+}
+
+// The vertices are in the screen space: x and y in pixels, z the depth from 0 to 1
+static void raster_triangle(const Vertex3D *v0, const Vertex3D *v1, const Vertex3D *v2)
+{
+    int x[3], y[3];
+    const Vertex3D *v[3] = { v0, v1, v2 };
+    for (int i = 0; i < 3; ++i) {
+        x[i] = pixel_floor(v[i]->position[0]*RASTER_SUBPIXELS + 0.5f);
+        y[i] = pixel_floor(v[i]->position[1]*RASTER_SUBPIXELS + 0.5f);
+    }
+    // The front faces are counter-clockwise on the screen, which makes the area negative with y
+    // pointing down. They are turned clockwise so the edge functions are positive inside.
+    int area = (x[1] - x[0])*(y[2] - y[0]) - (y[1] - y[0])*(x[2] - x[0]);
+    if (area >= 0) return;
+    area = -area;
+    const Vertex3D *swap = v1;
+    v1 = v2;
+    v2 = swap;
+    int swapX = x[1], swapY = y[1];
+    x[1] = x[2];
+    y[1] = y[2];
+    x[2] = swapX;
+    y[2] = swapY;
+
+    int minX = x[0], maxX = x[0], minY = y[0], maxY = y[0];
+    for (int i = 1; i < 3; ++i) {
+        if (x[i] < minX) minX = x[i];
+        if (x[i] > maxX) maxX = x[i];
+        if (y[i] < minY) minY = y[i];
+        if (y[i] > maxY) maxY = y[i];
+    }
+    float half = 0.5f*RASTER_SUBPIXELS;
+    int px0 = clamp(pixel_ceil((minX - half)/RASTER_SUBPIXELS), 0, framebuffer.width);
+    int px1 = clamp(pixel_floor((maxX - half)/RASTER_SUBPIXELS) + 1, 0, framebuffer.width);
+    int py0 = clamp(pixel_ceil((minY - half)/RASTER_SUBPIXELS), 0, framebuffer.height);
+    int py1 = clamp(pixel_floor((maxY - half)/RASTER_SUBPIXELS) + 1, 0, framebuffer.height);
+    if (px0 >= px1 || py0 >= py1) return;
+
+    // Edge i is the one opposite to the vertex i, and its function is the weight of that vertex
+    Raster raster;
+    int origin[3];
+    int centerX = px0*RASTER_SUBPIXELS + RASTER_SUBPIXELS/2;
+    int centerY = py0*RASTER_SUBPIXELS + RASTER_SUBPIXELS/2;
+    for (int i = 0; i < 3; ++i) {
+        int a = (i + 1)%3;
+        int b = (i + 2)%3;
+        int dx = x[b] - x[a];
+        int dy = y[b] - y[a];
+        raster.stepX[i] = -dy*RASTER_SUBPIXELS;
+        raster.stepY[i] = dx*RASTER_SUBPIXELS;
+        origin[i] = dx*(centerY - y[a]) - dy*(centerX - x[a]) - (is_top_left(dx, dy) ? 0 : 1);
+    }
+    raster.invArea = 1.0f/(float)area;
+    raster.z0 = v0->position[2];
+    raster.dz1 = v1->position[2] - v0->position[2];
+    raster.dz2 = v2->position[2] - v0->position[2];
+    raster.flat = true;
+    raster.opaque = true;
+    for (int c = 0; c < 4; ++c) {
+        // Rounded by the truncation
+        raster.color0[c] = v0->color[c] + 0.5f;
+        raster.dcolor1[c] = v1->color[c] - v0->color[c];
+        raster.dcolor2[c] = v2->color[c] - v0->color[c];
+        if (raster.dcolor1[c] != 0.0f || raster.dcolor2[c] != 0.0f) raster.flat = false;
+    }
+    if (v0->color[3] < 255.0f || v1->color[3] < 255.0f || v2->color[3] < 255.0f) raster.opaque = false;
+    raster.color = interpolate_color(&raster, 0.0f, 0.0f);
+
+    for (int ty = py0; ty < py1; ty += RASTER_TILE_SIZE) {
+        int tileHeight = (py1 - ty < RASTER_TILE_SIZE) ? py1 - ty : RASTER_TILE_SIZE;
+        for (int tx = px0; tx < px1; tx += RASTER_TILE_SIZE) {
+            int tileWidth = (px1 - tx < RASTER_TILE_SIZE) ? px1 - tx : RASTER_TILE_SIZE;
+            // The edge functions are linear, so the corners of the tile tell whether the whole
+            // tile is outside of an edge or inside of all of them
+            int w[3];
+            bool outside = false;
+            bool full = true;
+            for (int i = 0; i < 3; ++i) {
+                w[i] = origin[i] + (tx - px0)*raster.stepX[i] + (ty - py0)*raster.stepY[i];
+                int right = (tileWidth - 1)*raster.stepX[i];
+                int bottom = (tileHeight - 1)*raster.stepY[i];
+                int corners[4] = { w[i], w[i] + right, w[i] + bottom, w[i] + right + bottom };
+                int min = corners[0], max = corners[0];
+                for (int k = 1; k < 4; ++k) {
+                    if (corners[k] < min) min = corners[k];
+                    if (corners[k] > max) max = corners[k];
+                }
+                if (max < 0) outside = true;
+                if (min < 0) full = false;
+            }
+            if (outside) continue;
+            for (int row = 0; row < tileHeight; ++row) {
+                raster_span(&raster, ty + row, tx, tileWidth,
+                            w[0] + row*raster.stepY[0], w[1] + row*raster.stepY[1], w[2] + row*raster.stepY[2], full);
+            }
+        }
+    }
+}
+
+static void to_screen(Vertex3D *vertex)
+{
+    float invW = 1.0f/vertex->position[3];
+    vertex->position[0] = (vertex->position[0]*invW + 1.0f)*0.5f*framebuffer.width;
+    vertex->position[1] = (1.0f - vertex->position[1]*invW)*0.5f*framebuffer.height;
+    vertex->position[2] = vertex->position[2]*invW*0.5f + 0.5f;
+}
+
+static void draw_triangle_3d(Vertex3D a, Vertex3D b, Vertex3D c)
+{
+    Vertex3D polygon[MAX_CLIPPED_VERTICES] = { a, b, c };
+    int count = 3;
+    // Only the triangles that cross a plane of the frustum have to be clipped
+    for (int plane = 0; plane < 6; ++plane) {
+        bool inA = plane_distance(&a, plane) >= 0.0f;
+        bool inB = plane_distance(&b, plane) >= 0.0f;
+        bool inC = plane_distance(&c, plane) >= 0.0f;
+        if (!inA && !inB && !inC) return;
+        if (!inA || !inB || !inC) {
+            count = clip_polygon(polygon, count);
+            break;
+        }
+    }
+    for (int i = 0; i < count; ++i) to_screen(&polygon[i]);
+    for (int i = 2; i < count; ++i) raster_triangle(&polygon[0], &polygon[i - 1], &polygon[i]);
+}
+
+// Lines are 1 pixel wide and depth tested like the triangles
+static void draw_line_3d(Vertex3D a, Vertex3D b)
+{
+    // Liang-Barsky against the 6 planes of the frustum
+    float t0 = 0.0f;
+    float t1 = 1.0f;
+    for (int plane = 0; plane < 6; ++plane) {
+        float da = plane_distance(&a, plane);
+        float db = plane_distance(&b, plane);
+        if (da < 0.0f && db < 0.0f) return;
+        if (da < 0.0f) {
+            float t = da/(da - db);
+            if (t > t0) t0 = t;
+        } else if (db < 0.0f) {
+            float t = da/(da - db);
+            if (t < t1) t1 = t;
+        }
+    }
+    if (t0 > t1) return;
+    Vertex3D from = lerp_vertex(&a, &b, t0);
+    Vertex3D to = lerp_vertex(&a, &b, t1);
+    to_screen(&from);
+    to_screen(&to);
+
+    unsigned int color = color_pack((Color){ from.color[0], from.color[1], from.color[2], from.color[3] });
+    float dx = to.position[0] - from.position[0];
+    float dy = to.position[1] - from.position[1];
+    float adx = dx < 0.0f ? -dx : dx;
+    float ady = dy < 0.0f ? -dy : dy;
+    int steps = (int)(adx > ady ? adx : ady) + 1;
+    for (int i = 0; i <= steps; ++i) {
+        float t = (float)i/steps;
+        int px = pixel_floor(from.position[0] + dx*t);
+        int py = pixel_floor(from.position[1] + dy*t);
+        if (px < 0 || px >= framebuffer.width || py < 0 || py >= framebuffer.height) continue;
+        int index = py*framebuffer.width + px;
+        // Slightly closer, so the lines drawn along the faces aren't hidden by the rounding of the depth
+        float z = from.position[2] + (to.position[2] - from.position[2])*t - LINE_DEPTH_BIAS;
+        if (!(z <= depthbuffer[index])) continue;
+        depthbuffer[index] = z;
+        framebuffer.pixels[index] = blend(framebuffer.pixels[index], color);
+    }
+}
+
+void DrawLine3D(Vector3 startPos, Vector3 endPos, Color color)
+{
+    Transform3D transform = transform_3d(MatrixIdentity());
+    float colorf[4];
+    color_floats(color, colorf);
+    draw_line_3d(transform_vertex(&transform, startPos.x, startPos.y, startPos.z, colorf),
+                 transform_vertex(&transform, endPos.x, endPos.y, endPos.z, colorf));
+}
+
+void DrawTriangle3D(Vector3 v1, Vector3 v2, Vector3 v3, Color color)
+{
+    Transform3D transform = transform_3d(MatrixIdentity());
+    float colorf[4];
+    color_floats(color, colorf);
+    if (light_enabled) shade_color(face_normal(v1, v2, v3), colorf, colorf);
+    draw_triangle_3d(transform_vertex(&transform, v1.x, v1.y, v1.z, colorf),
+                     transform_vertex(&transform, v2.x, v2.y, v2.z, colorf),
+                     transform_vertex(&transform, v3.x, v3.y, v3.z, colorf));
+}
+
+void DrawCubeV(Vector3 position, Vector3 size, Color color)
+{
+    // Every face as (normal, u, v) with u×v = normal, so the triangles below are counter-clockwise
+    // from the outside like the ones of DrawCube() of raylib
+    static const float faces[6][3][3] = {
+        { {  0,  0,  1 }, { 1, 0, 0 }, { 0, 1, 0 } },
+        { {  0,  0, -1 }, { 0, 1, 0 }, { 1, 0, 0 } },
+        { {  0,  1,  0 }, { 0, 0, 1 }, { 1, 0, 0 } },
+        { {  0, -1,  0 }, { 1, 0, 0 }, { 0, 0, 1 } },
+        { {  1,  0,  0 }, { 0, 1, 0 }, { 0, 0, 1 } },
+        { { -1,  0,  0 }, { 0, 0, 1 }, { 0, 1, 0 } },
+    };
+    static const float corners[6][2] = { { -1, -1 }, { 1, -1 }, { -1, 1 }, { 1, 1 }, { -1, 1 }, { 1, -1 } };
+    Transform3D transform = transform_3d(MatrixTranslate(position.x, position.y, position.z));
+    float colorf[4];
+    color_floats(color, colorf);
+    float half[3] = { size.x/2, size.y/2, size.z/2 };
+    for (int f = 0; f < 6; ++f) {
+        float faceColor[4] = { colorf[0], colorf[1], colorf[2], colorf[3] };
+        if (light_enabled) shade_color((Vector3){ faces[f][0][0], faces[f][0][1], faces[f][0][2] }, colorf, faceColor);
+        Vertex3D vertices[6];
+        for (int k = 0; k < 6; ++k) {
+            float p[3];
+            for (int i = 0; i < 3; ++i) {
+                p[i] = (faces[f][0][i] + faces[f][1][i]*corners[k][0] + faces[f][2][i]*corners[k][1])*half[i];
+            }
+            vertices[k] = transform_vertex(&transform, p[0], p[1], p[2], faceColor);
+        }
+        draw_triangle_3d(vertices[0], vertices[1], vertices[2]);
+        draw_triangle_3d(vertices[3], vertices[4], vertices[5]);
+    }
+}
+
+void DrawCube(Vector3 position, float width, float height, float length, Color color)
+{
+    DrawCubeV(position, (Vector3){ width, height, length }, color);
+}
+
+void DrawCubeWiresV(Vector3 position, Vector3 size, Color color)
+{
+    Transform3D transform = transform_3d(MatrixTranslate(position.x, position.y, position.z));
+    float colorf[4];
+    color_floats(color, colorf);
+    Vertex3D corners[8];
+    for (int i = 0; i < 8; ++i) {
+        corners[i] = transform_vertex(&transform, (i & 1) ? size.x/2 : -size.x/2, (i & 2) ? size.y/2 : -size.y/2,
+                                      (i & 4) ? size.z/2 : -size.z/2, colorf);
+    }
+    // The corners that differ in one coordinate, which is one bit of their index
+    for (int i = 0; i < 8; ++i) {
+        for (int bit = 1; bit < 8; bit <<= 1) {
+            if ((i & bit) == 0) draw_line_3d(corners[i], corners[i | bit]);
+        }
+    }
+}
+
+void DrawCubeWires(Vector3 position, float width, float height, float length, Color color)
+{
+    DrawCubeWiresV(position, (Vector3){ width, height, length }, color);
+}
+
+void DrawPlane(Vector3 centerPos, Vector2 size, Color color)
+{
+    Transform3D transform = transform_3d(MatrixTranslate(centerPos.x, centerPos.y, centerPos.z));
+    float colorf[4];
+    color_floats(color, colorf);
+    if (light_enabled) shade_color((Vector3){ 0.0f, 1.0f, 0.0f }, colorf, colorf);
+    float x = size.x/2;
+    float z = size.y/2;
+    Vertex3D a = transform_vertex(&transform, -x, 0.0f, -z, colorf);
+    Vertex3D b = transform_vertex(&transform, -x, 0.0f, z, colorf);
+    Vertex3D c = transform_vertex(&transform, x, 0.0f, z, colorf);
+    Vertex3D d = transform_vertex(&transform, x, 0.0f, -z, colorf);
+    draw_triangle_3d(a, b, c);
+    draw_triangle_3d(a, c, d);
+}
+
+// Same lines and colors as DrawGrid() of raylib
+void DrawGrid(int slices, float spacing)
+{
+    Transform3D transform = transform_3d(MatrixIdentity());
+    int halfSlices = slices/2;
+    for (int i = -halfSlices; i <= halfSlices; ++i) {
+        float shade = (i == 0) ? 0.5f*255.0f : 0.75f*255.0f;
+        float colorf[4] = { shade, shade, shade, 255.0f };
+        float at = i*spacing;
+        float end = halfSlices*spacing;
+        draw_line_3d(transform_vertex(&transform, at, 0.0f, -end, colorf), transform_vertex(&transform, at, 0.0f, end, colorf));
+        draw_line_3d(transform_vertex(&transform, -end, 0.0f, at, colorf), transform_vertex(&transform, end, 0.0f, at, colorf));
+    }
+}
+
+// The texture of the material is not sampled, only its color is applied. With the light on, the
+// meshes with normals are Gouraud shaded and the others flat shaded.
+void DrawMesh(Mesh mesh, Material material, Matrix transform)
+{
+    if (mesh.vertices == NULL) return;
+    Transform3D mvp = transform_3d(transform);
+    Matrix normals = light_enabled ? normal_matrix(transform) : MatrixIdentity();
+    float diffuse[4] = { 255.0f, 255.0f, 255.0f, 255.0f };
+    if (material.maps != NULL) color_floats(material.maps[MATERIAL_MAP_DIFFUSE].color, diffuse);
+    int count = (mesh.indices != NULL) ? mesh.triangleCount*3 : mesh.vertexCount/3*3;
+    for (int i = 0; i < count; i += 3) {
+        Vector3 positions[3];
+        float colors[3][4];
+        for (int k = 0; k < 3; ++k) {
+            int index = (mesh.indices != NULL) ? mesh.indices[i + k] : i + k;
+            positions[k] = (Vector3){ mesh.vertices[3*index], mesh.vertices[3*index + 1], mesh.vertices[3*index + 2] };
+            for (int c = 0; c < 4; ++c) {
+                colors[k][c] = (mesh.colors != NULL) ? diffuse[c]*mesh.colors[4*index + c]/255.0f : diffuse[c];
+            }
+            if (light_enabled && mesh.normals != NULL) {
+                Vector3 normal = { mesh.normals[3*index], mesh.normals[3*index + 1], mesh.normals[3*index + 2] };
+                shade_color(Vector3Transform(normal, normals), colors[k], colors[k]);
+            }
+        }
+        if (light_enabled && mesh.normals == NULL) {
+            Vector3 normal = Vector3Transform(face_normal(positions[0], positions[1], positions[2]), normals);
+            for (int k = 0; k < 3; ++k) shade_color(normal, colors[k], colors[k]);
+        }
+        Vertex3D triangle[3];
+        for (int k = 0; k < 3; ++k) {
+            triangle[k] = transform_vertex(&mvp, positions[k].x, positions[k].y, positions[k].z, colors[k]);
+        }
+        draw_triangle_3d(triangle[0], triangle[1], triangle[2]);
+    }
+}
+
+void DrawModelEx(Model model, Vector3 position, Vector3 rotationAxis, float rotationAngle, Vector3 scale, Color tint)
+{
+    // Same transform as DrawModelEx() of raylib
+    Matrix matScale = MatrixScale(scale.x, scale.y, scale.z);
+    Matrix matRotation = MatrixRotate(rotationAxis, rotationAngle*DEG2RAD);
+    Matrix matTranslation = MatrixTranslate(position.x, position.y, position.z);
+    Matrix matTransform = MatrixMultiply(MatrixMultiply(matScale, matRotation), matTranslation);
+    model.transform = MatrixMultiply(model.transform, matTransform);
+
+    for (int i = 0; i < model.meshCount; ++i) {
+        Material material = model.materials[model.meshMaterial[i]];
+        MaterialMap diffuse = { .color = WHITE };
+        if (material.maps != NULL) diffuse = material.maps[MATERIAL_MAP_DIFFUSE];
+        diffuse.color = (Color){
+            diffuse.color.r*tint.r/255, diffuse.color.g*tint.g/255, diffuse.color.b*tint.b/255, diffuse.color.a*tint.a/255,
+        };
+        // The map is copied so the tint doesn't stay in the material of the game
+        material.maps = &diffuse;
+        DrawMesh(model.meshes[i], material, model.transform);
+    }
+}
+
+void DrawModel(Model model, Vector3 position, float scale, Color tint)
+{
+    DrawModelEx(model, position, (Vector3){ 0.0f, 1.0f, 0.0f }, 0.0f, (Vector3){ scale, scale, scale }, tint);
+}
+
+#endif // RAYLIB_JS_SOFTWARE_RENDERER
@@ -0,0 +1,169 @@
+// Fixed scenes for the software renderer (RAYLIB_JS_SOFTWARE_RENDERER). `./nob test` builds this
+// into a wasm module with the SIMD spans and into one without, and software_renderer.js checks
+// that both draw the same pixels.
+//
+// The sizes are not multiples of 4 on purpose, so the spans end with the scalar tail.
+#include <raylib.h>
+#define RAYMATH_STATIC_INLINE
+#include <raymath.h>
+#include "raylib_js.h"
+
+#define SCENE_TEXTURE_ID 0x10001
+#define SCENE_TEXTURE_WIDTH 7
+#define SCENE_TEXTURE_HEIGHT 5
+
+#define SCENE_3D_WIDTH 81
+#define SCENE_3D_HEIGHT 61
+
+// 2*RINGS*SLICES triangles, enough to time the rasterizer on
+#define SCENE_SPHERE_RINGS 48
+#define SCENE_SPHERE_SLICES 48
+#define SCENE_SPHERE_VERTICES ((SCENE_SPHERE_RINGS + 1)*(SCENE_SPHERE_SLICES + 1))
+#define SCENE_SPHERE_TRIANGLES (2*SCENE_SPHERE_RINGS*SCENE_SPHERE_SLICES)
+
+static unsigned int scene_texture[SCENE_TEXTURE_WIDTH*SCENE_TEXTURE_HEIGHT];
+static float sphere_vertices[3*SCENE_SPHERE_VERTICES];
+static unsigned short sphere_indices[3*SCENE_SPHERE_TRIANGLES];
+static bool sphere_generated = false;
+
+RaylibJsFramebuffer *raylib_js_framebuffer(void);
+bool raylib_js_software_bind_texture(unsigned int id, const unsigned int *pixels, int width, int height);
+void raylib_js_software_unbind_texture(unsigned int id);
+
+// Every shape of the 2D API over each other, with translucent colors so the blending shows, then
+// the text over all of them. software_renderer.js probes a pixel of each and every pixel of the
+// glyphs.
+RAYLIB_JS_EXPORT(scene_2d)
+void scene_2d(void)
+{
+    RaylibJsFramebuffer *framebuffer = raylib_js_framebuffer();
+    framebuffer->width = 97;
+    framebuffer->height = 61;
+
+    ClearBackground((Color){ 10, 20, 30, 255 });
+    DrawRectangle(3, 4, 50, 20, (Color){ 200, 100, 50, 128 });
+    DrawRectangleLines(10, 10, 30, 30, RED);
+    DrawCircle(40, 30, 17.3f, (Color){ 0, 255, 0, 77 });
+    DrawLine(0, 0, 96, 60, BLUE);
+    DrawLineEx((Vector2){ 5, 50 }, (Vector2){ 90, 10 }, 4, (Color){ 255, 255, 255, 200 });
+    DrawTriangle((Vector2){ 10, 10 }, (Vector2){ 10, 50 }, (Vector2){ 60, 50 }, (Color){ 255, 0, 255, 100 });
+    DrawTriangle((Vector2){ 70, 10 }, (Vector2){ 90, 50 }, (Vector2){ 60, 50 }, YELLOW);
+
+    // Texels of every alpha, with the ones of odd indices half transparent
+    for (int i = 0; i < SCENE_TEXTURE_WIDTH*SCENE_TEXTURE_HEIGHT; ++i) {
+        scene_texture[i] = 0x80000000u*(i%2) + i*0x030507u + (i%3)*0x40000000u;
+    }
+    raylib_js_software_bind_texture(SCENE_TEXTURE_ID, scene_texture, SCENE_TEXTURE_WIDTH, SCENE_TEXTURE_HEIGHT);
+    Texture2D texture = { .id = SCENE_TEXTURE_ID, .width = SCENE_TEXTURE_WIDTH, .height = SCENE_TEXTURE_HEIGHT };
+    DrawTexture(texture, 50, 5, WHITE);
+    DrawTexture(texture, 60, 5, (Color){ 200, 128, 255, 180 });
+    DrawTexturePro(texture, (Rectangle){ 1, 1, -5, 3 }, (Rectangle){ 30, 40, 33, 17 }, (Vector2){ 8, 4 }, 33.0f, (Color){ 255, 200, 100, 255 });
+    raylib_js_software_unbind_texture(SCENE_TEXTURE_ID);
+
+    DrawText("Hi\nthere", 2, 30, 20, YELLOW);
+}
+
+// Two cubes where the one drawn first is in front of the one drawn last, so only the depth buffer
+// puts the blue one over the red one where they overlap. software_renderer.js probes the pixels
+// of both and of the background.
+RAYLIB_JS_EXPORT(scene_3d)
+void scene_3d(void)
+{
+    RaylibJsFramebuffer *framebuffer = raylib_js_framebuffer();
+    framebuffer->width = SCENE_3D_WIDTH;
+    framebuffer->height = SCENE_3D_HEIGHT;
+
+    ClearBackground(RAYWHITE);
+    Camera3D camera = {
+        .position = { 0.0f, 0.0f, 10.0f },
+        .target = { 0.0f, 0.0f, 0.0f },
+        .up = { 0.0f, 1.0f, 0.0f },
+        .fovy = 45.0f,
+        .projection = CAMERA_PERSPECTIVE,
+    };
+    BeginMode3D(camera);
+    DrawCube((Vector3){ 1.0f, 0.0f, 1.5f }, 2.0f, 2.0f, 2.0f, BLUE);
+    DrawCube((Vector3){ 0.0f, 0.0f, 0.0f }, 2.0f, 2.0f, 2.0f, RED);
+    EndMode3D();
+}
+
+// The cube seen from a corner, lit from above, so each of the faces in view has its own shade.
+// software_renderer.js probes the three of them.
+RAYLIB_JS_EXPORT(scene_light)
+void scene_light(void)
+{
+    RaylibJsFramebuffer *framebuffer = raylib_js_framebuffer();
+    framebuffer->width = SCENE_3D_WIDTH;
+    framebuffer->height = SCENE_3D_HEIGHT;
+
+    ClearBackground(RAYWHITE);
+    Camera3D camera = {
+        .position = { 4.0f, 3.0f, 5.0f },
+        .target = { 0.0f, 0.0f, 0.0f },
+        .up = { 0.0f, 1.0f, 0.0f },
+        .fovy = 45.0f,
+        .projection = CAMERA_PERSPECTIVE,
+    };
+    SetSoftwareLight((Vector3){ -1.0f, -2.0f, -3.0f }, 0.25f);
+    BeginMode3D(camera);
+    DrawCube((Vector3){ 0.0f, 0.0f, 0.0f }, 2.0f, 2.0f, 2.0f, RED);
+    EndMode3D();
+    SetSoftwareLight((Vector3){ 0 }, 0.0f);
+}
+
+// A sphere of SCENE_SPHERE_TRIANGLES triangles with normals filling most of the framebuffer,
+// Gouraud shaded and turned by frame degrees. software_renderer.js times how long a frame of it
+// takes.
+RAYLIB_JS_EXPORT(scene_sphere)
+void scene_sphere(int frame)
+{
+    RaylibJsFramebuffer *framebuffer = raylib_js_framebuffer();
+    framebuffer->width = 643;
+    framebuffer->height = 481;
+
+    // Generated once, so the timing is of the drawing only. The normals of a unit sphere are its
+    // vertices.
+    for (int ring = 0; ring <= SCENE_SPHERE_RINGS && !sphere_generated; ++ring) {
+        float latitude = PI*ring/SCENE_SPHERE_RINGS;
+        for (int slice = 0; slice <= SCENE_SPHERE_SLICES; ++slice) {
+            float longitude = 2.0f*PI*slice/SCENE_SPHERE_SLICES;
+            float *vertex = &sphere_vertices[3*(ring*(SCENE_SPHERE_SLICES + 1) + slice)];
+            vertex[0] = sinf(latitude)*sinf(longitude);
+            vertex[1] = cosf(latitude);
+            vertex[2] = sinf(latitude)*cosf(longitude);
+        }
+    }
+    unsigned short *index = sphere_indices;
+    for (int ring = 0; ring < SCENE_SPHERE_RINGS && !sphere_generated; ++ring) {
+        for (int slice = 0; slice < SCENE_SPHERE_SLICES; ++slice) {
+            unsigned short a = ring*(SCENE_SPHERE_SLICES + 1) + slice;
+            unsigned short b = a + SCENE_SPHERE_SLICES + 1;
+            *index++ = a; *index++ = b; *index++ = a + 1;
+            *index++ = a + 1; *index++ = b; *index++ = b + 1;
+        }
+    }
+    sphere_generated = true;
+    Mesh mesh = {
+        .vertexCount = SCENE_SPHERE_VERTICES,
+        .triangleCount = SCENE_SPHERE_TRIANGLES,
+        .vertices = sphere_vertices,
+        .normals = sphere_vertices,
+        .indices = sphere_indices,
+    };
+    MaterialMap diffuse = { .color = ORANGE };
+    Material material = { .maps = &diffuse };
+
+    ClearBackground(DARKBLUE);
+    Camera3D camera = {
+        .position = { 0.0f, 0.0f, 3.0f },
+        .target = { 0.0f, 0.0f, 0.0f },
+        .up = { 0.0f, 1.0f, 0.0f },
+        .fovy = 45.0f,
+        .projection = CAMERA_PERSPECTIVE,
+    };
+    SetSoftwareLight((Vector3){ -1.0f, -2.0f, -3.0f }, 0.25f);
+    BeginMode3D(camera);
+    DrawMesh(mesh, material, MatrixRotateY(frame*DEG2RAD));
+    EndMode3D();
+    SetSoftwareLight((Vector3){ 0 }, 0.0f);
+}
@@ -0,0 +1,211 @@
+// Checks the software renderer against itself: every scene of software_renderer.c has to come out
+// the same with the SIMD spans and without them. The probes check a few pixels of the scenes
+// against the colors they should have, and every pixel of the glyphs of their text. Then the
+// frames of the timed scenes are drawn over and over, and how long one takes is printed. Run by
+// `./nob test` after it has built build/software_renderer_scalar.wasm and
+// build/software_renderer_simd.wasm.
+const fs = require("node:fs");
+
+const FRAMEBUFFER_WIDTH  = 0;
+const FRAMEBUFFER_HEIGHT = 4;
+const FRAMEBUFFER_PIXELS = 12;
+
+const DEFAULT_FONT_LINE_SPACING = 2;
+
+const WARMUP_FRAMES = 10;
+
+const SCENES = ["scene_2d", "scene_3d", "scene_light", "scene_sphere"];
+
+const RAYWHITE = 0xFFF5F5F5;
+const RED      = 0xFF3729E6;
+const BLUE     = 0xFFF17900;
+const YELLOW   = 0xFF00F9FD;
+const DARKBLUE = 0xFFAC5200;
+
+// The pixels that have to be of a given color, as [x, y, color, what is there]. The colors are
+// 0xAABBGGRR, the translucent ones blended over what is under them.
+const PROBES = {
+    scene_2d: [
+        [95, 2, 0xFF1E140A, "the background"],
+        [5, 6, 0xFF283C69, "the translucent rectangle"],
+        [25, 10, RED, "the outline of the rectangle"],
+        [40, 15, 0xFF1C7749, "the translucent circle over the rectangle"],
+        [50, 31, BLUE, "the line"],
+        [85, 13, 0xFFCECCCA, "the thick translucent line"],
+        [56, 49, 0xFF760C6A, "the translucent triangle"],
+        [80, 45, YELLOW, "the yellow triangle"],
+        [53, 5, 0xFF131110, "a half transparent texel of the texture"],
+        [63, 5, 0xFF17100C, "the same texel of the tinted texture"],
+        [47, 50, 0xFF131A21, "a texel of the rotated and flipped texture"],
+    ],
+    scene_3d: [
+        [5, 5, RAYWHITE, "the background"],
+        [36, 30, RED, "the red cube"],
+        [55, 30, BLUE, "the blue cube"],
+        [44, 30, BLUE, "the blue cube in front of the red one"],
+    ],
+    // RED lit at 0.25 + 0.75*max(0, dot(normal, the direction towards the light))
+    scene_light: [
+        [5, 5, RAYWHITE, "the background"],
+        [40, 20, 0xFF241B96, "the top of the cube, lit at 0.651"],
+        [50, 30, 0xFF191268, "the right of the cube, lit at 0.451"],
+        [32, 30, 0xFF2F23C4, "the front of the cube, lit at 0.851"],
+    ],
+    scene_sphere: [
+        [5, 5, DARKBLUE, "the background"],
+        [156, 360, 0xFF002840, "the side of the sphere away from the light, ORANGE at the ambient 0.25"],
+        [400, 150, 0xFF009EFA, "the side of the sphere facing the light, almost ORANGE"],
+    ],
+};
+
+// How many frames of the scenes are drawn to time them. scene_sphere is 4608 triangles.
+const TIMINGS = {
+    scene_sphere: 100,
+};
+
+// The text drawn last in the scenes, so the pixels of its glyphs are all of its color
+const TEXTS = {
+    scene_2d: [{text: "Hi\nthere", x: 2, y: 30, fontSize: 20, color: YELLOW}],
+};
+
+// Only what the renderer imports, the same as in raylib.js
+const env = {
+    floorf(x) { return Math.fround(Math.floor(x)); },
+    fabsf(x) { return Math.fround(Math.abs(x)); },
+    fmaxf(x, y) { return Math.fround(Math.max(x, y)); },
+    fminf(x, y) { return Math.fround(Math.min(x, y)); },
+    sqrtf(x) { return Math.fround(Math.sqrt(x)); },
+    atan2f(y, x) { return Math.fround(Math.atan2(y, x)); },
+    cosf(x) { return Math.fround(Math.cos(x)); },
+    sinf(x) { return Math.fround(Math.sin(x)); },
+    acosf(x) { return Math.fround(Math.acos(x)); },
+    asinf(x) { return Math.fround(Math.asin(x)); },
+    tan(x) { return Math.tan(x); },
+};
+
+async function load(wasmPath) {
+    const imports = {
+        env: new Proxy(env, {
+            get(target, prop) {
+                if (target[prop] !== undefined) return target[prop];
+                return (...args) => { throw new Error(`NOT IMPLEMENTED: ${prop} ${args}`); };
+            }
+        })
+    };
+    const { instance } = await WebAssembly.instantiate(fs.readFileSync(wasmPath), imports);
+    return instance.exports;
+}
+
+// Draws the scene and returns a copy of the framebuffer
+function render(exports, scene) {
+    exports[scene]();
+    const framebuffer = exports.raylib_js_framebuffer();
+    const i32 = new Int32Array(exports.memory.buffer);
+    const width = i32[(framebuffer + FRAMEBUFFER_WIDTH)>>2];
+    const height = i32[(framebuffer + FRAMEBUFFER_HEIGHT)>>2];
+    const pixels = new Uint32Array(exports.memory.buffer, framebuffer + FRAMEBUFFER_PIXELS, width*height).slice();
+    return { width, height, pixels };
+}
+
+// The probes of the pixels of the glyphs of the text, laid out like DrawText() of raylib does.
+// See RaylibJsDefaultFont in src/raylib_js.h.
+function textProbes(exports, { text, x, y, fontSize, color }) {
+    const font = exports.raylib_js_default_font()>>2;
+    const i32 = new Int32Array(exports.memory.buffer);
+    const f32 = new Float32Array(exports.memory.buffer);
+    const [baseSize, , atlasWidth, atlasHeight] = i32.subarray(font, font + 4);
+    const atlas = font + 4;
+    const recs = atlas + atlasWidth*atlasHeight/32;
+    const scale = fontSize/baseSize;
+    const spacing = Math.floor(fontSize/baseSize);
+    const probes = [];
+    let penX = x;
+    let penY = y;
+    for (const char of text) {
+        if (char === "\n") {
+            penX = x;
+            penY += fontSize + DEFAULT_FONT_LINE_SPACING;
+            continue;
+        }
+        const rec = recs + (char.codePointAt(0) - 32)*4;
+        const [recX, recY, recWidth, recHeight] = f32.subarray(rec, rec + 4);
+        for (let glyphY = 0; glyphY < recHeight; ++glyphY) {
+            for (let glyphX = 0; glyphX < recWidth; ++glyphX) {
+                const bit = (recY + glyphY)*atlasWidth + recX + glyphX;
+                if (((i32[atlas + (bit>>5)] >>> (bit&31)) & 1) === 0) continue;
+                // Every pixel of the glyph is a block of scale x scale pixels
+                for (let i = 0; i < scale*scale; ++i) {
+                    const px = penX + glyphX*scale + i%scale;
+                    const py = penY + glyphY*scale + Math.floor(i/scale);
+                    probes.push([px, py, color, `the glyph '${char}' of "${text.replace("\n", "\\n")}"`]);
+                }
+            }
+        }
+        penX += recWidth*scale + spacing;
+    }
+    return probes;
+}
+
+// How long a frame of the scene takes in milliseconds, the frame number passed to it. A few
+// frames are drawn first, so the module is optimized by then.
+function time(exports, scene, frames) {
+    for (let frame = 0; frame < WARMUP_FRAMES; ++frame) exports[scene](frame);
+    const start = performance.now();
+    for (let frame = 0; frame < frames; ++frame) exports[scene](frame);
+    return (performance.now() - start)/frames;
+}
+
+function hex(pixel) {
+    return `0x${pixel.toString(16).padStart(8, "0")}`;
+}
+
+async function main() {
+    const scalar = await load("./build/software_renderer_scalar.wasm");
+    const simd = await load("./build/software_renderer_simd.wasm");
+    let failed = 0;
+    for (const scene of SCENES) {
+        const expected = render(scalar, scene);
+        const actual = render(simd, scene);
+        const { width, height } = expected;
+        let different = 0;
+        for (let i = 0; i < expected.pixels.length; ++i) {
+            if (expected.pixels[i] === actual.pixels[i]) continue;
+            if (different === 0) {
+                console.log(`ERROR: ${scene}: the pixel at ${i%width}, ${Math.floor(i/width)} is ${hex(actual.pixels[i])} with SIMD and ${hex(expected.pixels[i])} without`);
+            }
+            different += 1;
+        }
+        if (different > 0 || actual.width !== width || actual.height !== height) {
+            console.log(`ERROR: ${scene}: ${different} of ${width*height} pixels differ`);
+            failed += 1;
+            continue;
+        }
+        const probes = [
+            ...PROBES[scene] ?? [],
+            ...(TEXTS[scene] ?? []).flatMap((text) => textProbes(scalar, text)),
+        ].filter(([x, y]) => x < width && y < height);
+        let wrong = 0;
+        for (const [x, y, color, what] of probes) {
+            const pixel = expected.pixels[y*width + x];
+            if (pixel === color) continue;
+            console.log(`ERROR: ${scene}: the pixel at ${x}, ${y} is ${hex(pixel)} instead of ${hex(color)} of ${what}`);
+            wrong += 1;
+        }
+        if (wrong > 0) {
+            failed += 1;
+        } else {
+            console.log(`OK: ${scene}: ${width}x${height}, ${probes.length} probes`);
+        }
+    }
+    for (const [scene, frames] of Object.entries(TIMINGS)) {
+        const withSimd = time(simd, scene, frames);
+        const withoutSimd = time(scalar, scene, frames);
+        console.log(`TIME: ${scene}: ${withSimd.toFixed(2)} ms/frame with SIMD, ${withoutSimd.toFixed(2)} ms/frame without, over ${frames} frames`);
+    }
+    process.exit(failed > 0 ? 1 : 0);
+}
+
+main().catch((e) => {
+    console.error(e);
+    process.exit(1);
+});